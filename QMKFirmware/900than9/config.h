@@ -1,12 +1,24 @@
 #pragma once
 
 #define DYNAMIC_KEYMAP_LAYER_COUNT 6
+// 키코드 RAM 캐시에 둘 레이어 수 (my_keymap.h, 레이어당 216B). SRAM이 부족하면 줄임
+#define MYFI_KEYCODE_CACHE_LAYERS 6
 #define USB_POLLING_INTERVAL_MS 1
 #define FORCE_NKRO
 
+// 확장 설정 레코드 (my_config.c). 크기를 바꾸면 QMK가 데이터블록을 초기화하므로 여유를 두고 고정
+#define EECONFIG_KB_DATA_SIZE 32
+
 // LED Pins: A6, A7, B0
 // A6 = ESC, A7 = SCROLL, B0 = CAPS
 // TIM3 타이머 사용: A6 = TIM3_CH1, A7 = TIM3_CH2, B0 = TIM3_CH3
+// 출력 드라이버는 my_led.c (rules.mk의 MYFI_LED_DRIVER로 pwm/soft 선택)
+// 채널 수/핀/기본값은 아래 정의만 바꾸면 이펙트 엔진, 설정 레이아웃, VIA 채널 라우팅이 따라감
+#define MY_LED_COUNT              3
+#define MY_LED_PINS               { A6, A7, B0 }
+#define MY_LED_PWM_CHANNELS       { 0, 1, 2 }   // TIM3 채널 인덱스 (CH1 = 0)
+#define MY_LED_DEFAULT_FLAGS      { 12, 4, 9 }  // A6: Edge+Invert, A7: Edge, B0: Hold+Invert
+#define MY_LED_DEFAULT_INDICATORS { 0, 1, 2 }   // A6: none, A7: scroll, B0: caps
 
 // // LED Indicators 설정
 // #define LED_KANA_PIN A6
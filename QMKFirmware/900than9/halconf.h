@@ -1,7 +1,13 @@
 #pragma once
 
 
-// #define HAL_USE_PWM TRUE
+// A6/A7/B0 LED 하드웨어 PWM (rules.mk: MYFI_LED_DRIVER = pwm)
+#ifdef MYFI_LED_DRIVER_PWM
+#define HAL_USE_PWM TRUE
+#endif
 
 
+// 깊은 유휴에서 행 핀 EXTI로 깨어남 (my_matrix.c)
+#define PAL_USE_CALLBACKS TRUE
+
 #include_next <halconf.h>
@@ -4,49 +4,23 @@
 #include QMK_KEYBOARD_H
 #include "my_config.h"
 #include "my_effect.h"
+#include "my_led.h"
 #include "os_detection.h"
 #include "my_keycode.h"
-
-typedef bool (*key_handler_t)(bool pressed, os_variant_t host);
+#include "my_perf.h"
+#include "my_idle.h"
+#include "my_keymap.h"
+#include "my_boot.h"
 
 // 효과 비트 매크로는 my_effect.h에서 제공
 
-// LED 핀 정의
-#define LED_PIN_A6 A6
-#define LED_PIN_A7 A7
-#define LED_PIN_B0 B0
-
-#define IDX_A6 0
-#define IDX_A7 1
-#define IDX_B0 2
-
-#define PIN_COUNT 3
-static const pin_t kPins[PIN_COUNT] = { LED_PIN_A6, LED_PIN_A7, LED_PIN_B0 };
-
-// 인디케이터 소스: myfi 설정 사용 (0:none,1:scroll,2:caps)
-typedef enum {
-    IND_NONE = 0,
-    IND_SCROLL = 1,
-    IND_CAPS = 2,
-} indicator_t;
-
-static inline uint8_t get_pin_mode(uint8_t idx)
-{
-    return my_config_get_led_flags(idx);
-}
-static inline indicator_t get_indicator_src(uint8_t idx)
-{
-    return (indicator_t)my_config_get_indicator(idx);
-}
-
+// 핫패스에서는 디코딩 캐시(g_my_config_cache)만 읽음
 static inline bool require_typing_state_update(void)
 {
-    const uint8_t m0 = get_pin_mode(IDX_A6);
-    const uint8_t m1 = get_pin_mode(IDX_A7);
-    const uint8_t m2 = get_pin_mode(IDX_B0);
-    return (((m0 | m1 | m2) & EFFECT_NEEDS_STATE) != 0);
+    return g_my_config_cache.needs_typing_state;
 }
 
+// 레이어 0 (조밀). 위 레이어는 아래 희소 목록으로 저장 (my_keymap.h)
 const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
 
     // clang-format off
@@ -58,87 +32,99 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
         MO(1),   KC_LSFT, KC_Z,    KC_X,    KC_C,    KC_V,    KC_B,    KC_N,    KC_M,    KC_COMM, KC_DOT,  KC_SLSH,          KC_RSFT, MO(1),               KC_UP,
         KC_LCTL, KC_LGUI, KC_LGUI, KC_LALT, KC_RCTL,  KC_SPC,           KC_SPC,           KC_SPC,           KC_RALT,  KC_RGUI, KC_RGUI, KC_RCTL,    KC_LEFT, KC_DOWN, KC_RGHT
     ),
-    [1] = LAYOUT(
-        XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX,
-        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX,
-        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,             XXXXXXX, XXXXXXX, XXXXXXX,
-        XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-        MO(1),   XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX, MO(1),               XXXXXXX,
-        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX,          XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX
-    ),
-    [2] = LAYOUT(
-        XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX,
-        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX,
-        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,             XXXXXXX, XXXXXXX, XXXXXXX,
-        XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-        MO(1),   XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX, MO(1),               XXXXXXX,
-        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX,          XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX
-    ),
-    [3] = LAYOUT(
-        XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX,
-        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX,
-        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,             XXXXXXX, XXXXXXX, XXXXXXX,
-        XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-        MO(1),   XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX, MO(1),               XXXXXXX,
-        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX,          XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX
-    ),
     // clang-format on
 };
 
+// 레이어 1~3: 모두 XXXXXXX, 양쪽 MO(1) 자리(좌/우 Shift 바깥쪽)만 MO(1)
+static const my_keymap_override_t kMoOverrides[] = {
+    { 4,  0, MO(1) },
+    { 4, 14, MO(1) },
+};
+
+// 레이어 1부터 차례로 쌓이는 희소 기본 레이어. EEPROM 초기화 때 my_keymap_seed_sparse_layers가
+// 동적 키맵에 펼쳐 기록함 (my_keymap.h)
+const my_keymap_sparse_layer_t g_my_sparse_layers[] = {
+    [0] = { XXXXXXX, ARRAY_SIZE(kMoOverrides), kMoOverrides }, // 레이어 1
+    [1] = { XXXXXXX, ARRAY_SIZE(kMoOverrides), kMoOverrides }, // 레이어 2
+    [2] = { XXXXXXX, ARRAY_SIZE(kMoOverrides), kMoOverrides }, // 레이어 3
+};
+const uint8_t g_my_sparse_layer_count = ARRAY_SIZE(g_my_sparse_layers);
 
 void keyboard_post_init_user(void)
 {
-    // A6, A7, B0 핀 출력 설정
-    setPinOutput(LED_PIN_A6);
-    setPinOutput(LED_PIN_A7);
-    setPinOutput(LED_PIN_B0);
+    my_boot_mark(MY_BOOT_POST_INIT);
+    // A6, A7, B0 LED 출력 드라이버 초기화는 첫 보고서 뒤로 미룸 (my_boot_task)
     my_effect_init();
+#ifdef MYFI_PERF_ENABLE
+    my_perf_init();
+#endif
 }
 
-void matrix_scan_user(void)
+void housekeeping_task_user(void)
 {
-    led_t leds = host_keyboard_led_state();
-    for (uint8_t i = 0; i < PIN_COUNT; i++)
+    MY_PERF_BEGIN(perf_start);
+    // 시각은 루프당 한 번만 읽어서 각 모듈에 넘김
+    const uint32_t now = timer_read32();
+    // 부팅 단계 기록, 첫 보고서 뒤에 LED 드라이버 초기화
+    my_boot_task(now);
+    // LED 출력은 다음 변화 시점이 될 때만 다시 계산됨 (깊은 유휴 중에는 꺼 둔 상태 유지)
+    if (my_boot_ready() && my_idle_level() != MY_IDLE_DEEP)
     {
-        const pin_t pin = kPins[i];
-        const indicator_t ind = get_indicator_src(i);
-        const uint8_t mode = get_pin_mode(i);
+        my_effect_task(now);
+        my_led_task();
+    }
+    // 단축키 시퀀스는 프레임당 보고서 하나씩 비동기로 재생
+    my_keycode_task(now);
+    // VIA 설정 변경은 입력이 멈춘 뒤에 EEPROM에 기록
+    my_config_task(now);
+    // 입력이 없으면 스캔 감속 / 깊은 유휴 단계로 전환
+    my_idle_task();
+    MY_PERF_END(MY_PERF_HOUSEKEEPING, perf_start);
+}
 
-        bool ind_on = false;
-        if (ind == IND_SCROLL) ind_on = leds.scroll_lock;
-        else if (ind == IND_CAPS) ind_on = leds.caps_lock;
+void suspend_power_down_user(void)
+{
+    // suspend 중에는 릴리즈 이벤트가 오지 않으므로 눌린 키 집합을 비움
+    my_effect_reset();
+    // suspend 중에는 housekeeping이 돌지 않으므로 LED/PWM 출력을 꺼진 상태로 고정
+    if (my_boot_ready()) my_led_sleep();
+}
 
-        if (ind_on) { writePinHigh(pin); }
-        else { my_effect_apply_pin_effect(pin, mode); }
-    }
+void suspend_wakeup_init_user(void)
+{
+    // 출력은 다음 my_effect_task에서 다시 계산됨
+    my_effect_reset();
 }
 
-void housekeeping_task_user(void)
+bool led_update_user(led_t led_state)
 {
-    led_t leds = host_keyboard_led_state();
-    for (uint8_t i = 0; i < PIN_COUNT; i++)
-    {
-        const pin_t pin = kPins[i];
-        const indicator_t ind = get_indicator_src(i);
-        const uint8_t mode = get_pin_mode(i);
-
-        // 인디케이터 ON이면 이펙트 무시
-        bool ind_on = false;
-        if (ind == IND_SCROLL) ind_on = leds.scroll_lock;
-        else if (ind == IND_CAPS) ind_on = leds.caps_lock;
-        my_effect_update_effects_for_pin(pin, mode, ind_on);
-    }
+    my_effect_set_host_leds(led_state);
+    return true;
 }
 
 bool process_record_user(uint16_t keycode, keyrecord_t* record)
 {
+    // 단축키 시퀀스 재생 중에는 이벤트를 보관했다가 끝난 뒤 순서대로 처리 (my_keycode.c)
+    if (my_keycode_defer_record(record)) return false;
+
+    MY_PERF_BEGIN(perf_start);
+    // 보류됐던 이벤트는 다시 들어온 이때 해석됨 (누름 -> 보고서 지연도 그만큼 포함)
+    if (record->event.pressed) MY_PERF_PRESS_RESOLVE(record->event.key, keycode);
     if (require_typing_state_update())
     {
-        my_effect_update_typing_state_from_key_event(record->event.pressed);
+        my_effect_update_typing_state_from_key_event(record->event.key, record->event.pressed);
     }
 
-    os_variant_t host = detected_host_os();
-    if (!process_my_custom_keycodes(keycode, record->event.pressed, host)) return false;
+    const bool handled = process_my_custom_keycodes(keycode, record->event.pressed);
 
+    MY_PERF_END(MY_PERF_PROCESS_RECORD, perf_start);
+    return handled;
+}
+
+bool process_detected_host_os_user(os_variant_t detected_os)
+{
+    // 감지 결과는 my_keycode에 캐시되고 OS별 테이블은 여기서 한 번만 선택됨
+    if (detected_os != OS_UNSURE) my_boot_mark(MY_BOOT_OS_DETECTED);
+    my_keycode_set_detected_os(detected_os);
     return true;
 }
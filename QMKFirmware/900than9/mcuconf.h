@@ -1,4 +1,8 @@
 #pragma once
 #include_next <mcuconf.h>
-// #undef STM32_PWM_USE_TIM3
-// #define STM32_PWM_USE_TIM3 TRUE
+
+// A6/A7/B0 = TIM3_CH1/CH2/CH3 (rules.mk: MYFI_LED_DRIVER = pwm)
+#ifdef MYFI_LED_DRIVER_PWM
+#undef STM32_PWM_USE_TIM3
+#define STM32_PWM_USE_TIM3 TRUE
+#endif
@@ -0,0 +1,93 @@
+// myfi: 부팅 단계 타임스탬프와 첫 보고서 이후로 미루는 초기화
+#include "my_boot.h"
+#include "host.h"
+#include "usb_main.h"
+#include "my_effect.h"
+#include "my_led.h"
+#include "my_perf.h"
+
+bool g_my_boot_ready;
+
+static uint32_t s_boot_ms[MY_BOOT_EVENT_COUNT];
+static uint8_t s_boot_reached;
+
+// 원래 호스트 드라이버와 보고서 전송만 바꾼 사본 (첫 보고서 기록, 누름->보고서 지연 계측)
+static host_driver_t* s_host_driver;
+static host_driver_t s_wrapped_driver;
+
+void my_boot_mark(uint8_t event)
+{
+    if (event >= MY_BOOT_EVENT_COUNT || (s_boot_reached & BIT(event))) return;
+    s_boot_reached |= (uint8_t)BIT(event);
+    s_boot_ms[event] = timer_read32();
+}
+
+static void report_sent(void)
+{
+    if (!(s_boot_reached & BIT(MY_BOOT_FIRST_REPORT))) my_boot_mark(MY_BOOT_FIRST_REPORT);
+}
+
+static void wrapped_send_keyboard(report_keyboard_t* report)
+{
+    report_sent();
+    MY_PERF_REPORT_KEYBOARD(report);
+    s_host_driver->send_keyboard(report);
+}
+
+static void wrapped_send_nkro(report_nkro_t* report)
+{
+    report_sent();
+    MY_PERF_REPORT_NKRO(report);
+    s_host_driver->send_nkro(report);
+}
+
+static void wrap_host_driver(void)
+{
+    // 호스트 드라이버는 keyboard_init 이후(protocol_post_init)에 설정되므로 init 시점이 아닌 여기서 감쌈
+    host_driver_t* driver = host_get_driver();
+    if (driver == NULL || driver == &s_wrapped_driver) return;
+    s_host_driver = driver;
+    s_wrapped_driver = *driver;
+    s_wrapped_driver.send_keyboard = wrapped_send_keyboard;
+    s_wrapped_driver.send_nkro = wrapped_send_nkro;
+    host_set_driver(&s_wrapped_driver);
+}
+
+void my_boot_task(uint32_t now)
+{
+    wrap_host_driver();
+    if (g_my_boot_ready) return;
+
+    if (USB_DRIVER.state == USB_ACTIVE) my_boot_mark(MY_BOOT_USB_CONFIGURED);
+
+    // 첫 보고서가 나갔거나, 보고서 없이 충분히 기다렸으면 미뤄 둔 초기화 실행
+    if ((s_boot_reached & BIT(MY_BOOT_FIRST_REPORT)) || now >= MY_BOOT_DEFER_MAX_MS)
+    {
+        my_led_init();
+        my_effect_request_update();
+        my_boot_mark(MY_BOOT_DEFERRED_INIT);
+        g_my_boot_ready = true;
+    }
+}
+
+#ifdef VIA_ENABLE
+void my_boot_via_command(uint8_t* command_id, uint8_t* value_id_and_data, uint8_t length)
+{
+    uint8_t* out = &value_id_and_data[1];
+    if (*command_id == id_custom_get_value && value_id_and_data[0] == 0 && length >= 2u + MY_BOOT_EVENT_COUNT * 4u)
+    {
+        out[0] = s_boot_reached;
+        for (uint8_t i = 0; i < MY_BOOT_EVENT_COUNT; i++)
+        {
+            for (uint8_t b = 0; b < 4; b++)
+            {
+                out[1 + i * 4 + b] = (uint8_t)(s_boot_ms[i] >> (8u * b));
+            }
+        }
+    }
+    else
+    {
+        *command_id = id_unhandled;
+    }
+}
+#endif
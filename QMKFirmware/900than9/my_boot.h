@@ -0,0 +1,40 @@
+#pragma once
+
+#include "quantum.h"
+
+// 부팅 단계 타임스탬프 (ms, timer_read32 기준). t = 0은 ChibiOS 시작 = 리셋 직후
+enum my_boot_event {
+    MY_BOOT_MATRIX_INIT = 0, // matrix_init_kb 진입 (eeconfig 읽기 전)
+    MY_BOOT_POST_INIT,       // keyboard_post_init_user
+    MY_BOOT_USB_CONFIGURED,  // 호스트가 USB 구성을 마침 (첫 열거)
+    MY_BOOT_OS_DETECTED,     // 첫 OS 감지 결과 (OS_UNSURE 제외)
+    MY_BOOT_FIRST_REPORT,    // 첫 키보드 보고서 전송
+    MY_BOOT_DEFERRED_INIT,   // 미뤄 둔 초기화(LED) 실행
+    MY_BOOT_EVENT_COUNT
+};
+
+// 첫 보고서 전에는 필수 작업만 함: 설정 기본값 기록은 지연 저장(my_config_task)으로, LED 초기화는
+// 첫 보고서 뒤로 미룸. 키를 누르지 않아 보고서가 없으면 이 시간이 지난 뒤 실행
+#define MY_BOOT_DEFER_MAX_MS 1500u
+
+// VIA 채널 41: 부팅 타임스탬프 읽기
+// get value id 0: [도달 비트 u8 (bit i = enum my_boot_event i)][ms u32 x MY_BOOT_EVENT_COUNT]
+#define MYFI_VIA_CHANNEL_BOOT 41
+
+extern bool g_my_boot_ready;
+
+// 미뤄 둔 초기화가 끝났는지 (LED 출력 경로는 이 뒤에만 동작)
+static inline bool my_boot_ready(void)
+{
+    return g_my_boot_ready;
+}
+
+// 단계 도달 기록 (처음 한 번만 기록)
+void my_boot_mark(uint8_t event);
+
+// housekeeping에서 매 루프 호출: 호스트 드라이버 감싸기, USB 구성 감지, 미뤄 둔 초기화
+void my_boot_task(uint32_t now);
+
+#ifdef VIA_ENABLE
+void my_boot_via_command(uint8_t* command_id, uint8_t* value_id_and_data, uint8_t length);
+#endif
@@ -2,23 +2,43 @@
 #include "my_config.h"
 #include "quantum.h"
 #include "eeprom.h"
+#include "my_effect.h"
+#include "my_keycode.h"
+#include "my_debounce.h"
+#include "my_perf.h"
+#include "my_idle.h"
+#include "my_boot.h"
+#include "my_keymap.h"
+#include "os_detection.h"
 
 #ifndef BIT
 #define BIT(n) (1u << (n))
 #endif
 
 my_config_t g_my_config;
+my_config_ext_t g_my_config_ext;
+my_config_cache_t g_my_config_cache;
 
 // --- Bit packing layout (LSB-first) ---
-#define MYFI_A6_SHIFT      0u
-#define MYFI_A7_SHIFT      5u
-#define MYFI_B0_SHIFT      10u
-#define MYFI_IND_A6_SHIFT  15u
-#define MYFI_IND_A7_SHIFT  17u
-#define MYFI_IND_B0_SHIFT  19u
+// [핀별 LED 플래그 5비트 x N][핀별 인디케이터 2비트 x N][호스트 OS 2비트]
+// N = 3이면 기존 배치(플래그 0/5/10, 인디케이터 15/17/19, 호스트 OS 21)와 동일
+#define MYFI_FLAGS_BITS    5u
+#define MYFI_IND_BITS      2u
+#define MYFI_FLAGS_SHIFT(i) ((uint32_t)(i) * MYFI_FLAGS_BITS)
+#define MYFI_IND_SHIFT(i)   ((uint32_t)MY_CONFIG_PIN_COUNT * MYFI_FLAGS_BITS + (uint32_t)(i) * MYFI_IND_BITS)
+#define MYFI_HOST_OS_SHIFT  ((uint32_t)MY_CONFIG_PIN_COUNT * (MYFI_FLAGS_BITS + MYFI_IND_BITS))
 
 #define MYFI_FLAGS_MASK    0x1Fu
 #define MYFI_IND_MASK      0x03u
+#define MYFI_HOST_OS_MASK  0x03u
+
+_Static_assert(MYFI_HOST_OS_SHIFT + 2u <= 32u, "per-pin fields no longer fit in the 32-bit kb word; move them to the extended record");
+
+// 범위 밖 핀 인덱스는 마지막 채널로 고정
+static inline uint8_t my_config_pin_index(uint8_t idx)
+{
+    return (idx >= MY_CONFIG_PIN_COUNT) ? (uint8_t)(MY_CONFIG_PIN_COUNT - 1u) : idx;
+}
 
 static inline uint32_t my_config_pack_field(uint32_t raw, uint32_t value, uint32_t shift, uint32_t mask)
 {
@@ -32,73 +52,370 @@ static inline uint32_t my_config_unpack_field(uint32_t raw, uint32_t shift, uint
     return (raw >> shift) & mask;
 }
 
-static void read_my_config_from_eeprom(my_config_t* config)
+// raw 워드는 kb 데이터블록 맨 끝에 둠. EECONFIG_KB_DATA_SIZE > 0이면 QMK가 eeconfig kb 워드 자리를
+// 데이터블록 버전으로 쓰기 때문에 (eeconfig_update_kb_datablock이 매번 기록, 다르면 데이터블록을 무효로 봄)
+// eeconfig_update_kb로 raw를 쓰면 확장 레코드가 매 부팅 무효가 되고 raw는 버전 값으로 덮임
+#define MY_CONFIG_RAW_OFFSET (EECONFIG_KB_DATA_SIZE - sizeof(uint32_t))
+
+// raw를 새로 써야 하면 true 반환
+static bool read_my_config_from_eeprom(my_config_t* config)
 {
-    config->raw = eeconfig_read_kb();
+    if (!eeconfig_is_kb_datablock_valid())
+    {
+        // 데이터블록을 쓰기 전 펌웨어: raw는 kb 워드에 있음. 다음 커밋에서 데이터블록으로 옮김
+        config->raw = eeconfig_read_kb();
+        return true;
+    }
+    eeconfig_read_kb_datablock(&config->raw, MY_CONFIG_RAW_OFFSET, sizeof(config->raw));
+    return false;
 }
 
 static void write_my_config_to_eeprom(const my_config_t* config)
 {
-    eeconfig_update_kb(config->raw);
+    eeconfig_update_kb_datablock(&config->raw, MY_CONFIG_RAW_OFFSET, sizeof(config->raw));
+}
+
+// --- 확장 설정 레코드 ---
+typedef struct __attribute__((packed)) {
+    uint8_t  version; // MY_CONFIG_EXT_VERSION (0/0xFF = 없음)
+    uint8_t  length;  // 저장된 본문 길이
+    uint16_t crc;     // 본문 CRC-16/CCITT
+} my_config_ext_header_t;
+
+#define MY_CONFIG_EXT_BODY_MAX (MY_CONFIG_RAW_OFFSET - sizeof(my_config_ext_header_t))
+_Static_assert(sizeof(my_config_ext_t) <= MY_CONFIG_EXT_BODY_MAX, "EECONFIG_KB_DATA_SIZE too small for my_config_ext_t");
+
+// 플래시에 기록된 내용의 사본: 커밋 시 달라진 바이트 구간만 쓰기 위해 사용
+static my_config_ext_t s_ext_stored;
+static my_config_ext_header_t s_ext_header_stored;
+static bool s_ext_stored_valid;
+
+static uint16_t my_config_crc16(const uint8_t* data, uint8_t length)
+{
+    uint16_t crc = 0xFFFFu;
+    for (uint8_t i = 0; i < length; i++)
+    {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t b = 0; b < 8; b++)
+        {
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void my_config_ext_apply_defaults(my_config_ext_t* ext)
+{
+    for (uint8_t i = 0; i < MY_CONFIG_PIN_COUNT; i++)
+    {
+        ext->breath_curve[i] = EFFECT_BREATH_CURVE;
+        ext->brightness[i] = MY_LED_FULL;
+        ext->breath_phase[i] = 0;
+    }
+    ext->debounce_ms = MY_DEBOUNCE_DEFAULT_MS;
+    ext->idle_light_s = MY_IDLE_DEFAULT_LIGHT_S;
+    ext->idle_deep_min = MY_IDLE_DEFAULT_DEEP_MIN;
+    ext->last_os = OS_UNSURE;
+}
+
+static void my_config_ext_sanitize(my_config_ext_t* ext)
+{
+    for (uint8_t i = 0; i < MY_CONFIG_PIN_COUNT; i++)
+    {
+        if (ext->breath_curve[i] >= EFFECT_CURVE_COUNT) ext->breath_curve[i] = EFFECT_BREATH_CURVE;
+    }
+    if (ext->debounce_ms > MY_DEBOUNCE_MAX_MS) ext->debounce_ms = MY_DEBOUNCE_DEFAULT_MS;
+    if (ext->last_os > OS_IOS) ext->last_os = OS_UNSURE;
+}
+
+static void my_config_ext_header_make(my_config_ext_header_t* header, const my_config_ext_t* ext)
+{
+    header->version = MY_CONFIG_EXT_VERSION;
+    header->length = (uint8_t)sizeof(*ext);
+    header->crc = my_config_crc16((const uint8_t*)ext, (uint8_t)sizeof(*ext));
+}
+
+// 부팅 시 한 번 RAM으로 로드. 레코드를 새로 써야 하면 true 반환
+static bool read_my_config_ext_from_eeprom(void)
+{
+    my_config_ext_header_t header;
+    uint8_t body[MY_CONFIG_EXT_BODY_MAX];
+
+    my_config_ext_apply_defaults(&g_my_config_ext);
+    eeconfig_read_kb_datablock(&header, 0, sizeof(header));
+
+    bool valid = (header.version != 0u) && (header.version != 0xFFu) && (header.length <= sizeof(body));
+    if (valid)
+    {
+        eeconfig_read_kb_datablock(body, sizeof(header), header.length);
+        valid = (my_config_crc16(body, header.length) == header.crc);
+    }
+
+    if (!valid)
+    {
+        // 레코드 없음/손상: 기본값 사용, 플래시 사본은 무효로 두어 다음 커밋에서 전체 기록
+        s_ext_stored_valid = false;
+        return true;
+    }
+
+    // 필드 단위 마이그레이션: 저장된 길이까지는 그대로, 이후 버전에서 추가된 필드는 기본값 유지
+    uint8_t copy = (header.length < sizeof(g_my_config_ext)) ? header.length : (uint8_t)sizeof(g_my_config_ext);
+    memcpy(&g_my_config_ext, body, copy);
+    my_config_ext_sanitize(&g_my_config_ext);
+
+    // 길이가 다르면 저장된 길이 이후 바이트는 알 수 없으므로 다음 커밋에서 전체 기록
+    const bool needs_rewrite = (header.version != MY_CONFIG_EXT_VERSION) || (header.length != sizeof(g_my_config_ext));
+    memcpy(&s_ext_stored, body, copy);
+    s_ext_header_stored = header;
+    s_ext_stored_valid = !needs_rewrite;
+    return needs_rewrite;
+}
+
+// 달라진 바이트 구간만 기록한 뒤 마지막에 헤더(CRC)를 갱신
+static void write_my_config_ext_to_eeprom(void)
+{
+    const uint8_t* cur = (const uint8_t*)&g_my_config_ext;
+    const uint8_t* old = (const uint8_t*)&s_ext_stored;
+    const uint8_t size = (uint8_t)sizeof(g_my_config_ext);
+
+    if (!s_ext_stored_valid)
+    {
+        eeconfig_update_kb_datablock(cur, sizeof(my_config_ext_header_t), size);
+    }
+    else
+    {
+        uint8_t i = 0;
+        while (i < size)
+        {
+            if (cur[i] == old[i]) { i++; continue; }
+            uint8_t start = i;
+            while (i < size && cur[i] != old[i]) i++;
+            eeconfig_update_kb_datablock(cur + start, sizeof(my_config_ext_header_t) + start, (uint32_t)(i - start));
+        }
+    }
+    s_ext_stored = g_my_config_ext;
+
+    my_config_ext_header_t header;
+    my_config_ext_header_make(&header, &g_my_config_ext);
+    if (!s_ext_stored_valid || memcmp(&header, &s_ext_header_stored, sizeof(header)) != 0)
+    {
+        eeconfig_update_kb_datablock(&header, 0, sizeof(header));
+        s_ext_header_stored = header;
+    }
+    s_ext_stored_valid = true;
+}
+
+// --- 지연 저장 (write-back) ---
+// VIA에서 값을 바꿀 때마다 바로 쓰지 않고 dirty만 표시. 변경과 입력이 모두 멈추고
+// 눌린 키가 없을 때 한 번만 커밋해서, 플래시 페이지 소거가 타이핑 도중에 끼어들지 않게 함
+static bool s_config_dirty;
+static uint32_t s_config_dirty_time;
+
+static void my_config_mark_dirty(void)
+{
+    s_config_dirty = true;
+    s_config_dirty_time = timer_read32();
+}
+
+void my_config_commit(void)
+{
+    if (!s_config_dirty) return;
+    s_config_dirty = false;
+    write_my_config_to_eeprom(&g_my_config);
+    write_my_config_ext_to_eeprom();
+}
+
+void my_config_task(uint32_t now)
+{
+    if (!s_config_dirty) return;
+    if ((uint32_t)(now - s_config_dirty_time) < MY_CONFIG_COMMIT_IDLE_MS) return;
+    // 타이핑이 시작되면 조용해질 때까지 다시 미룸
+    if (last_input_activity_elapsed() < MY_CONFIG_COMMIT_IDLE_MS) return;
+    if (my_idle_any_key_down()) return;
+    my_config_commit();
 }
 
 static void my_config_apply_defaults(my_config_t* config)
 {
+    // 핀별 기본 효과/인디케이터는 config.h (MY_LED_DEFAULT_FLAGS / MY_LED_DEFAULT_INDICATORS)
+    static const uint8_t kDefaultFlags[MY_CONFIG_PIN_COUNT] = MY_LED_DEFAULT_FLAGS;
+    static const uint8_t kDefaultIndicators[MY_CONFIG_PIN_COUNT] = MY_LED_DEFAULT_INDICATORS;
+
     uint32_t raw = 0u;
-    // keymap.c 기본 효과: A6: Edge+Invert(12), A7: Edge(4), B0: Hold+Invert(9)
-    raw = my_config_pack_field(raw, (uint32_t)(BIT(2) | BIT(3)), MYFI_A6_SHIFT, MYFI_FLAGS_MASK);
-    raw = my_config_pack_field(raw, (uint32_t)(BIT(2)),          MYFI_A7_SHIFT, MYFI_FLAGS_MASK);
-    raw = my_config_pack_field(raw, (uint32_t)(BIT(0) | BIT(3)), MYFI_B0_SHIFT, MYFI_FLAGS_MASK);
-    // 인디케이터 기본: A6:none(0), A7:scroll(1), B0:caps(2)
-    raw = my_config_pack_field(raw, 0u, MYFI_IND_A6_SHIFT, MYFI_IND_MASK);
-    raw = my_config_pack_field(raw, 1u, MYFI_IND_A7_SHIFT, MYFI_IND_MASK);
-    raw = my_config_pack_field(raw, 2u, MYFI_IND_B0_SHIFT, MYFI_IND_MASK);
+    for (uint8_t i = 0; i < MY_CONFIG_PIN_COUNT; i++)
+    {
+        raw = my_config_pack_field(raw, kDefaultFlags[i], MYFI_FLAGS_SHIFT(i), MYFI_FLAGS_MASK);
+        raw = my_config_pack_field(raw, kDefaultIndicators[i], MYFI_IND_SHIFT(i), MYFI_IND_MASK);
+    }
     // 버전 필드는 더 이상 사용하지 않음
     config->raw = raw;
 }
 
+void my_config_refresh_cache(void)
+{
+    my_config_cache_t* cache = &g_my_config_cache;
+    uint8_t all_flags = 0;
+    cache->invert_mask = 0;
+    for (uint8_t i = 0; i < MY_CONFIG_PIN_COUNT; i++)
+    {
+        // 저장된 값이 정의되지 않은 조합이어도 여기서 정규화하고 핀 동작을 한 번만 결정
+        const uint8_t flags = my_effect_normalize_flags(my_config_get_led_flags(i));
+        cache->led_flags[i] = flags;
+        cache->behavior[i] = my_effect_behavior_for(flags);
+        cache->invert_mask |= (uint8_t)(my_effect_invert_for(flags) << i);
+        cache->indicator[i] = my_config_get_indicator(i);
+        cache->breath_curve[i] = g_my_config_ext.breath_curve[i];
+        cache->brightness[i] = g_my_config_ext.brightness[i];
+        cache->breath_phase[i] = g_my_config_ext.breath_phase[i];
+        all_flags |= flags;
+    }
+    cache->needs_typing_state = (all_flags & EFFECT_NEEDS_STATE) != 0;
+    cache->host_os = my_config_get_host_os();
+    cache->has_breathing = (all_flags & LED_MODE_BREATHING) != 0;
+    my_debounce_set_window(g_my_config_ext.debounce_ms);
+    my_effect_request_update();
+    my_keycode_update_host_os();
+}
+
 void eeconfig_init_kb(void)
 {
     my_config_apply_defaults(&g_my_config);
-    write_my_config_to_eeprom(&g_my_config);
+    my_config_ext_apply_defaults(&g_my_config_ext);
+    // 부팅 중 초기화일 수 있으므로 기록은 지연 저장으로 넘김. QMK가 데이터블록을 지웠으므로 전체 기록
+    s_ext_stored_valid = false;
+    my_config_mark_dirty();
+    my_config_refresh_cache();
+    // eeconfig_init_quantum은 이 훅 직전에 동적 키맵을 리셋함 (레이어 0만 채워진 상태)
+    my_keymap_seed_sparse_layers();
     eeconfig_init_user();
 }
 
 void matrix_init_kb(void)
 {
-    read_my_config_from_eeprom(&g_my_config);
-    // 기본값 미설정 시 기본값 적용 후 저장
+    my_boot_mark(MY_BOOT_MATRIX_INIT);
+    // 기본값 미설정 시 기본값 적용. 기록은 첫 보고서 전에 하지 않도록 유휴 시점으로 미룸
+    const bool raw_moved = read_my_config_from_eeprom(&g_my_config);
     if (g_my_config.raw == 0u || g_my_config.raw == 0xFFFFFFFFu)
     {
         my_config_apply_defaults(&g_my_config);
-        write_my_config_to_eeprom(&g_my_config);
+        my_config_mark_dirty();
+    }
+    else if (raw_moved)
+    {
+        my_config_mark_dirty();
     }
+    // 확장 레코드가 없거나 이전 버전이면 마이그레이션 결과를 유휴 시점에 기록
+    if (read_my_config_ext_from_eeprom())
+    {
+        my_config_mark_dirty();
+    }
+    my_config_refresh_cache();
     matrix_init_user();
 }
 
 uint8_t my_config_get_led_flags(uint8_t idx)
 {
-    static const uint8_t shifts[3] = { MYFI_A6_SHIFT, MYFI_A7_SHIFT, MYFI_B0_SHIFT };
-    return (uint8_t)my_config_unpack_field(g_my_config.raw, shifts[(idx > 2) ? 2 : idx], MYFI_FLAGS_MASK);
+    return (uint8_t)my_config_unpack_field(g_my_config.raw, MYFI_FLAGS_SHIFT(my_config_pin_index(idx)), MYFI_FLAGS_MASK);
 }
 
 void my_config_set_led_flags(uint8_t idx, uint8_t flags)
 {
-    static const uint8_t shifts[3] = { MYFI_A6_SHIFT, MYFI_A7_SHIFT, MYFI_B0_SHIFT };
-    g_my_config.raw = my_config_pack_field(g_my_config.raw, flags, shifts[(idx > 2) ? 2 : idx], MYFI_FLAGS_MASK);
+    // VIA에서 읽어 갈 때도 유효한 드롭다운 값이 되도록 정규화해서 저장
+    g_my_config.raw = my_config_pack_field(g_my_config.raw, my_effect_normalize_flags(flags), MYFI_FLAGS_SHIFT(my_config_pin_index(idx)), MYFI_FLAGS_MASK);
 }
 
 uint8_t my_config_get_indicator(uint8_t idx)
 {
-    static const uint8_t shifts[3] = { MYFI_IND_A6_SHIFT, MYFI_IND_A7_SHIFT, MYFI_IND_B0_SHIFT };
-    return (uint8_t)my_config_unpack_field(g_my_config.raw, shifts[(idx > 2) ? 2 : idx], MYFI_IND_MASK);
+    return (uint8_t)my_config_unpack_field(g_my_config.raw, MYFI_IND_SHIFT(my_config_pin_index(idx)), MYFI_IND_MASK);
 }
 
 void my_config_set_indicator(uint8_t idx, uint8_t indicator)
 {
-    static const uint8_t shifts[3] = { MYFI_IND_A6_SHIFT, MYFI_IND_A7_SHIFT, MYFI_IND_B0_SHIFT };
     uint8_t v = (indicator > 2u) ? 0u : indicator;
-    g_my_config.raw = my_config_pack_field(g_my_config.raw, v, shifts[(idx > 2) ? 2 : idx], MYFI_IND_MASK);
+    g_my_config.raw = my_config_pack_field(g_my_config.raw, v, MYFI_IND_SHIFT(my_config_pin_index(idx)), MYFI_IND_MASK);
+}
+
+uint8_t my_config_get_host_os(void)
+{
+    return (uint8_t)my_config_unpack_field(g_my_config.raw, MYFI_HOST_OS_SHIFT, MYFI_HOST_OS_MASK);
+}
+
+void my_config_set_host_os(uint8_t host_os)
+{
+    uint8_t v = (host_os > MY_HOST_OS_MACOS) ? MY_HOST_OS_AUTO : host_os;
+    g_my_config.raw = my_config_pack_field(g_my_config.raw, v, MYFI_HOST_OS_SHIFT, MYFI_HOST_OS_MASK);
+}
+
+uint8_t my_config_get_breath_curve(uint8_t idx)
+{
+    return g_my_config_ext.breath_curve[my_config_pin_index(idx)];
+}
+
+void my_config_set_breath_curve(uint8_t idx, uint8_t curve)
+{
+    g_my_config_ext.breath_curve[my_config_pin_index(idx)] = (curve >= EFFECT_CURVE_COUNT) ? EFFECT_BREATH_CURVE : curve;
+}
+
+uint8_t my_config_get_brightness(uint8_t idx)
+{
+    return g_my_config_ext.brightness[my_config_pin_index(idx)];
+}
+
+void my_config_set_brightness(uint8_t idx, uint8_t brightness)
+{
+    g_my_config_ext.brightness[my_config_pin_index(idx)] = brightness;
+}
+
+uint8_t my_config_get_breath_phase(uint8_t idx)
+{
+    return g_my_config_ext.breath_phase[my_config_pin_index(idx)];
+}
+
+void my_config_set_breath_phase(uint8_t idx, uint8_t phase)
+{
+    g_my_config_ext.breath_phase[my_config_pin_index(idx)] = phase;
+}
+
+uint8_t my_config_get_debounce(void)
+{
+    return g_my_config_ext.debounce_ms;
+}
+
+void my_config_set_debounce(uint8_t ms)
+{
+    g_my_config_ext.debounce_ms = (ms > MY_DEBOUNCE_MAX_MS) ? MY_DEBOUNCE_MAX_MS : ms;
+}
+
+uint8_t my_config_get_last_os(void)
+{
+    return g_my_config_ext.last_os;
+}
+
+void my_config_set_last_os(uint8_t os)
+{
+    if (os == OS_UNSURE || os > OS_IOS || os == g_my_config_ext.last_os) return;
+    g_my_config_ext.last_os = os;
+    my_config_mark_dirty();
+}
+
+uint8_t my_config_get_idle_light_s(void)
+{
+    return g_my_config_ext.idle_light_s;
+}
+
+void my_config_set_idle_light_s(uint8_t seconds)
+{
+    g_my_config_ext.idle_light_s = seconds;
+}
+
+uint8_t my_config_get_idle_deep_min(void)
+{
+    return g_my_config_ext.idle_deep_min;
+}
+
+void my_config_set_idle_deep_min(uint8_t minutes)
+{
+    g_my_config_ext.idle_deep_min = minutes;
 }
 
 #ifdef VIA_ENABLE
@@ -116,6 +433,19 @@ void custom_config_get_value(uint8_t *data)
         case id_custom_indicator_a6: *value_data = my_config_get_indicator(0); break;
         case id_custom_indicator_a7: *value_data = my_config_get_indicator(1); break;
         case id_custom_indicator_b0: *value_data = my_config_get_indicator(2); break;
+        case id_custom_host_os:      *value_data = my_config_get_host_os(); break;
+        case id_custom_breath_curve_a6: *value_data = my_config_get_breath_curve(0); break;
+        case id_custom_breath_curve_a7: *value_data = my_config_get_breath_curve(1); break;
+        case id_custom_breath_curve_b0: *value_data = my_config_get_breath_curve(2); break;
+        case id_custom_brightness_a6:   *value_data = my_config_get_brightness(0); break;
+        case id_custom_brightness_a7:   *value_data = my_config_get_brightness(1); break;
+        case id_custom_brightness_b0:   *value_data = my_config_get_brightness(2); break;
+        case id_custom_debounce_ms:     *value_data = my_config_get_debounce(); break;
+        case id_custom_idle_light_s:    *value_data = my_config_get_idle_light_s(); break;
+        case id_custom_idle_deep_min:   *value_data = my_config_get_idle_deep_min(); break;
+        case id_custom_breath_phase_a6: *value_data = my_config_get_breath_phase(0); break;
+        case id_custom_breath_phase_a7: *value_data = my_config_get_breath_phase(1); break;
+        case id_custom_breath_phase_b0: *value_data = my_config_get_breath_phase(2); break;
     }
 }
 
@@ -123,7 +453,7 @@ void my_config_save_if_changed(uint32_t before_raw)
 {
     if (g_my_config.raw != before_raw)
     {
-        write_my_config_to_eeprom(&g_my_config);
+        my_config_mark_dirty();
     }
 }
 
@@ -132,6 +462,7 @@ void custom_config_set_value(uint8_t *data)
     uint8_t *value_id   = &(data[0]);
     uint8_t *value_data = &(data[1]);
     uint32_t before_raw = g_my_config.raw;
+    my_config_ext_t before_ext = g_my_config_ext;
 
     switch (*value_id)
     {
@@ -141,36 +472,122 @@ void custom_config_set_value(uint8_t *data)
         case id_custom_indicator_a6: my_config_set_indicator(0, *value_data); break;
         case id_custom_indicator_a7: my_config_set_indicator(1, *value_data); break;
         case id_custom_indicator_b0: my_config_set_indicator(2, *value_data); break;
+        case id_custom_host_os:      my_config_set_host_os(*value_data); break;
+        case id_custom_breath_curve_a6: my_config_set_breath_curve(0, *value_data); break;
+        case id_custom_breath_curve_a7: my_config_set_breath_curve(1, *value_data); break;
+        case id_custom_breath_curve_b0: my_config_set_breath_curve(2, *value_data); break;
+        case id_custom_brightness_a6:   my_config_set_brightness(0, *value_data); break;
+        case id_custom_brightness_a7:   my_config_set_brightness(1, *value_data); break;
+        case id_custom_brightness_b0:   my_config_set_brightness(2, *value_data); break;
+        case id_custom_debounce_ms:     my_config_set_debounce(*value_data); break;
+        case id_custom_idle_light_s:    my_config_set_idle_light_s(*value_data); break;
+        case id_custom_idle_deep_min:   my_config_set_idle_deep_min(*value_data); break;
+        case id_custom_breath_phase_a6: my_config_set_breath_phase(0, *value_data); break;
+        case id_custom_breath_phase_a7: my_config_set_breath_phase(1, *value_data); break;
+        case id_custom_breath_phase_b0: my_config_set_breath_phase(2, *value_data); break;
     }
 
+    my_config_refresh_cache();
+    if (memcmp(&before_ext, &g_my_config_ext, sizeof(before_ext)) != 0)
+    {
+        my_config_mark_dirty();
+    }
     my_config_save_if_changed(before_raw);
 }
 
+// 채널 setter 뒤에 호출: raw 워드나 확장 레코드에서 실제로 바뀐 바이트가 있을 때만
+// 캐시를 다시 만들고 저장 예약 (같은 값을 다시 보내면 EEPROM 쓰기 없음)
+static void my_config_apply_if_changed(uint32_t before_raw, const my_config_ext_t *before_ext)
+{
+    if (g_my_config.raw == before_raw && memcmp(before_ext, &g_my_config_ext, sizeof(*before_ext)) == 0) return;
+    my_config_refresh_cache();
+    my_config_mark_dirty();
+}
+
+// 일괄 채널: 받은 값은 개별 setter와 같은 규칙으로 정규화한 뒤 한 번에 반영
+static void my_config_bulk_get(uint8_t *data)
+{
+    uint8_t *p = &data[MYFI_VIA_BULK_HEADER];
+    data[2] = MY_CONFIG_EXT_VERSION;
+    for (uint8_t b = 0; b < sizeof(uint32_t); b++)
+    {
+        *p++ = (uint8_t)(g_my_config.raw >> (8u * b));
+    }
+    memcpy(p, &g_my_config_ext, sizeof(g_my_config_ext));
+}
+
+static bool my_config_bulk_set(const uint8_t *data)
+{
+    if (data[2] != MY_CONFIG_EXT_VERSION) return false;
+
+    const uint8_t *p = &data[MYFI_VIA_BULK_HEADER];
+    uint32_t raw = 0;
+    for (uint8_t b = 0; b < sizeof(uint32_t); b++)
+    {
+        raw |= (uint32_t)*p++ << (8u * b);
+    }
+    const uint32_t before_raw = g_my_config.raw;
+    const my_config_ext_t before_ext = g_my_config_ext;
+
+    g_my_config.raw = raw;
+    for (uint8_t i = 0; i < MY_CONFIG_PIN_COUNT; i++)
+    {
+        my_config_set_led_flags(i, my_config_get_led_flags(i));
+        my_config_set_indicator(i, my_config_get_indicator(i));
+    }
+    my_config_set_host_os(my_config_get_host_os());
+    // 정의된 필드 밖의 비트는 버림
+    g_my_config.raw &= (1uL << (MYFI_HOST_OS_SHIFT + 2u)) - 1u;
+
+    memcpy(&g_my_config_ext, p, sizeof(g_my_config_ext));
+    // last_os는 설정이 아니라 이 장치의 감지 결과이므로 다른 장치/이전 백업 값으로 덮지 않음
+    g_my_config_ext.last_os = before_ext.last_os;
+    my_config_ext_sanitize(&g_my_config_ext);
+
+    my_config_apply_if_changed(before_raw, &before_ext);
+    return true;
+}
+
 void via_custom_value_command_kb(uint8_t *data, uint8_t length)
 {
     uint8_t *command_id        = &(data[0]);
     uint8_t *channel_id        = &(data[1]);
     uint8_t *value_id_and_data = &(data[2]);
 
-    // 채널 우선 라우팅: 컨트롤 분리 (10/11/12: LED flags A6/A7/B0, 20/21/22: indicator A6/A7/B0)
+    // 채널 우선 라우팅: 컨트롤 분리 (10 + i: 핀 i LED, 20 + i: 핀 i indicator)
     uint8_t ch = *channel_id;
-    if (ch >= 10 && ch <= 12)
+    if (ch >= MYFI_VIA_CHANNEL_LED_BASE && ch < MYFI_VIA_CHANNEL_LED_BASE + MY_CONFIG_PIN_COUNT)
     {
-        uint8_t idx = (uint8_t)(ch - 10);
-        // flags channel
+        uint8_t idx = (uint8_t)(ch - MYFI_VIA_CHANNEL_LED_BASE);
+        uint8_t value_id = value_id_and_data[0];
+        // flags channel (value id 0: LED 플래그, 1: 브리딩 곡선, 2: 최대 밝기, 3: 브리딩 위상)
         if (*command_id == id_custom_set_value)
         {
             uint8_t v = value_id_and_data[1];
-            my_config_set_led_flags(idx, v);
-            write_my_config_to_eeprom(&g_my_config);
+            const uint32_t before_raw = g_my_config.raw;
+            const my_config_ext_t before_ext = g_my_config_ext;
+            switch (value_id)
+            {
+                case MYFI_VIA_LED_BREATH_CURVE: my_config_set_breath_curve(idx, v); break;
+                case MYFI_VIA_LED_BRIGHTNESS:   my_config_set_brightness(idx, v); break;
+                case MYFI_VIA_LED_BREATH_PHASE: my_config_set_breath_phase(idx, v); break;
+                default:                        my_config_set_led_flags(idx, v); break;
+            }
+            my_config_apply_if_changed(before_raw, &before_ext);
         }
         else if (*command_id == id_custom_get_value)
         {
-            value_id_and_data[1] = my_config_get_led_flags(idx);
+            switch (value_id)
+            {
+                case MYFI_VIA_LED_BREATH_CURVE: value_id_and_data[1] = my_config_get_breath_curve(idx); break;
+                case MYFI_VIA_LED_BRIGHTNESS:   value_id_and_data[1] = my_config_get_brightness(idx); break;
+                case MYFI_VIA_LED_BREATH_PHASE: value_id_and_data[1] = my_config_get_breath_phase(idx); break;
+                default:                        value_id_and_data[1] = my_config_get_led_flags(idx); break;
+            }
         }
         else if (*command_id == id_custom_save)
         {
-            write_my_config_to_eeprom(&g_my_config);
+            my_config_commit();
         }
         else
         {
@@ -178,15 +595,17 @@ void via_custom_value_command_kb(uint8_t *data, uint8_t length)
         }
         return;
     }
-    else if (ch >= 20 && ch <= 22)
+    else if (ch >= MYFI_VIA_CHANNEL_INDICATOR_BASE && ch < MYFI_VIA_CHANNEL_INDICATOR_BASE + MY_CONFIG_PIN_COUNT)
     {
-        uint8_t idx = (uint8_t)(ch - 20);
+        uint8_t idx = (uint8_t)(ch - MYFI_VIA_CHANNEL_INDICATOR_BASE);
         // indicator channel
         if (*command_id == id_custom_set_value)
         {
             uint8_t v = value_id_and_data[1];
+            const uint32_t before_raw = g_my_config.raw;
+            const my_config_ext_t before_ext = g_my_config_ext;
             my_config_set_indicator(idx, v);
-            write_my_config_to_eeprom(&g_my_config);
+            my_config_apply_if_changed(before_raw, &before_ext);
         }
         else if (*command_id == id_custom_get_value)
         {
@@ -194,7 +613,116 @@ void via_custom_value_command_kb(uint8_t *data, uint8_t length)
         }
         else if (*command_id == id_custom_save)
         {
-            write_my_config_to_eeprom(&g_my_config);
+            my_config_commit();
+        }
+        else
+        {
+            *command_id = id_unhandled;
+        }
+        return;
+    }
+    else if (ch == MYFI_VIA_CHANNEL_HOST_OS)
+    {
+        // host OS channel
+        if (*command_id == id_custom_set_value)
+        {
+            uint8_t v = value_id_and_data[1];
+            const uint32_t before_raw = g_my_config.raw;
+            const my_config_ext_t before_ext = g_my_config_ext;
+            my_config_set_host_os(v);
+            my_config_apply_if_changed(before_raw, &before_ext);
+        }
+        else if (*command_id == id_custom_get_value)
+        {
+            value_id_and_data[1] = my_config_get_host_os();
+        }
+        else if (*command_id == id_custom_save)
+        {
+            my_config_commit();
+        }
+        else
+        {
+            *command_id = id_unhandled;
+        }
+        return;
+    }
+    else if (ch == MYFI_VIA_CHANNEL_DEBOUNCE)
+    {
+        // debounce channel
+        if (*command_id == id_custom_set_value)
+        {
+            uint8_t v = value_id_and_data[1];
+            const uint32_t before_raw = g_my_config.raw;
+            const my_config_ext_t before_ext = g_my_config_ext;
+            my_config_set_debounce(v);
+            my_config_apply_if_changed(before_raw, &before_ext);
+        }
+        else if (*command_id == id_custom_get_value)
+        {
+            value_id_and_data[1] = my_config_get_debounce();
+        }
+        else if (*command_id == id_custom_save)
+        {
+            my_config_commit();
+        }
+        else
+        {
+            *command_id = id_unhandled;
+        }
+        return;
+    }
+    else if (ch == MYFI_VIA_CHANNEL_IDLE)
+    {
+        uint8_t value_id = value_id_and_data[0];
+        // idle channel (value id 0: 스캔 감속 초, 1: 깊은 유휴 분)
+        if (*command_id == id_custom_set_value)
+        {
+            uint8_t v = value_id_and_data[1];
+            const uint32_t before_raw = g_my_config.raw;
+            const my_config_ext_t before_ext = g_my_config_ext;
+            switch (value_id)
+            {
+                case MYFI_VIA_IDLE_DEEP_MIN: my_config_set_idle_deep_min(v); break;
+                default:                     my_config_set_idle_light_s(v); break;
+            }
+            my_config_apply_if_changed(before_raw, &before_ext);
+        }
+        else if (*command_id == id_custom_get_value)
+        {
+            switch (value_id)
+            {
+                case MYFI_VIA_IDLE_DEEP_MIN: value_id_and_data[1] = my_config_get_idle_deep_min(); break;
+                default:                     value_id_and_data[1] = my_config_get_idle_light_s(); break;
+            }
+        }
+        else if (*command_id == id_custom_save)
+        {
+            my_config_commit();
+        }
+        else
+        {
+            *command_id = id_unhandled;
+        }
+        return;
+    }
+    else if (ch == MYFI_VIA_CHANNEL_BULK)
+    {
+        // bulk channel (value id 자리 = 레코드 버전)
+        if (length < MYFI_VIA_BULK_SIZE)
+        {
+            *command_id = id_unhandled;
+        }
+        else if (*command_id == id_custom_set_value)
+        {
+            if (!my_config_bulk_set(data)) *command_id = id_unhandled;
+        }
+        else if (*command_id == id_custom_get_value)
+        {
+            my_config_bulk_get(data);
+        }
+        else if (*command_id == id_custom_save)
+        {
+            my_config_commit();
         }
         else
         {
@@ -202,6 +730,20 @@ void via_custom_value_command_kb(uint8_t *data, uint8_t length)
         }
         return;
     }
+    else if (ch == MYFI_VIA_CHANNEL_BOOT)
+    {
+        // boot timing channel (읽기 전용)
+        my_boot_via_command(command_id, value_id_and_data, (uint8_t)(length - 2));
+        return;
+    }
+#ifdef MYFI_PERF_ENABLE
+    else if (ch == MYFI_VIA_CHANNEL_PERF)
+    {
+        // diagnostics channel (읽기 전용 계측값, set = 초기화)
+        my_perf_via_command(command_id, value_id_and_data, (uint8_t)(length - 2));
+        return;
+    }
+#endif
 
     *command_id = id_unhandled;
 }
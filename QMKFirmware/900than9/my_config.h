@@ -8,9 +8,72 @@ typedef union {
 
 extern my_config_t g_my_config;
 
-// 변경이 있을 경우에만 EEPROM 저장
+// LED 채널 수 (config.h의 MY_LED_COUNT)
+#define MY_CONFIG_PIN_COUNT MY_LED_COUNT
+
+// --- 확장 설정 레코드 (eeconfig kb 데이터블록) ---
+// [헤더: version, length, crc16][본문: my_config_ext_t] ... [raw 워드 (데이터블록 마지막 4바이트)]
+// 필드는 뒤에만 추가하고 추가할 때마다 MY_CONFIG_EXT_VERSION을 올림. 이전 버전 레코드는
+// 저장된 길이까지만 읽고 새 필드는 기본값으로 채움. 기존 필드의 의미는 바꾸지 않음
+#define MY_CONFIG_EXT_VERSION 5u
+
+typedef struct __attribute__((packed)) {
+    // v1
+    uint8_t breath_curve[MY_CONFIG_PIN_COUNT]; // enum effect_breath_curve
+    uint8_t brightness[MY_CONFIG_PIN_COUNT];   // 핀별 최대 밝기 (0..255)
+    // v2
+    uint8_t debounce_ms;                       // 디바운스 창 (0..MY_DEBOUNCE_MAX_MS)
+    // v3
+    uint8_t idle_light_s;                      // 스캔 감속까지의 무입력 시간 (초, 0 = 사용 안 함)
+    uint8_t idle_deep_min;                     // 깊은 유휴(WFI)까지의 무입력 시간 (분, 0 = 사용 안 함)
+    // v4
+    uint8_t breath_phase[MY_CONFIG_PIN_COUNT]; // 핀별 브리딩 위상 오프셋 (주기의 1/256 단위)
+    // v5
+    uint8_t last_os;                           // 마지막 OS 감지 결과 (os_variant_t). 부팅 직후 감지 전의 추정값
+} my_config_ext_t;
+
+extern my_config_ext_t g_my_config_ext;
+
+
+// 호스트 OS 고정 (VIA에서 선택, 오감지나 KVM 전환 시 재연결 없이 지정)
+enum my_host_os_override {
+    MY_HOST_OS_AUTO = 0, // OS 감지 결과 사용
+    MY_HOST_OS_WINDOWS,
+    MY_HOST_OS_MACOS,
+};
+
+// raw/확장 레코드에서 디코딩한 설정. 설정이 바뀔 때만 갱신되며 스캔/키 이벤트 경로는 이 값만 읽음.
+// 채널별 값은 struct-of-arrays로 두어 이펙트 엔진이 모든 채널을 한 루프에서 처리함
+typedef struct {
+    uint8_t led_flags[MY_CONFIG_PIN_COUNT];    // LED_MODE_* 비트 OR 값 (정규화됨)
+    uint8_t indicator[MY_CONFIG_PIN_COUNT];    // 0:none, 1:scroll, 2:caps
+    uint8_t behavior[MY_CONFIG_PIN_COUNT];     // enum effect_behavior (led_flags에서 결정)
+    uint8_t breath_curve[MY_CONFIG_PIN_COUNT]; // enum effect_breath_curve
+    uint8_t brightness[MY_CONFIG_PIN_COUNT];   // 최대 밝기
+    uint8_t breath_phase[MY_CONFIG_PIN_COUNT]; // 브리딩 위상 오프셋 (주기의 1/256 단위)
+    uint8_t invert_mask;                       // bit i = 채널 i 출력 XOR (INVERT 또는 FORCE_ON)
+    bool needs_typing_state; // 타이핑 상태가 필요한 모드(hold/edge)를 쓰는 핀이 하나라도 있는지
+    uint8_t host_os;         // enum my_host_os_override
+    bool has_breathing;      // 브리딩 모드를 쓰는 핀이 있는지 (있으면 스캔 감속 유휴를 쓰지 않음)
+} my_config_cache_t;
+
+extern my_config_cache_t g_my_config_cache;
+
+// g_my_config.raw / g_my_config_ext 변경 후 호출해서 디코딩 캐시를 다시 만든다
+void my_config_refresh_cache(void);
+
+// 변경이 있을 경우에만 저장 예약 (실제 EEPROM 쓰기는 my_config_task/my_config_commit)
 void my_config_save_if_changed(uint32_t before_raw);
 
+// 변경 후 입력 없이 이 시간이 지나고 눌린 키가 없으면 커밋
+#define MY_CONFIG_COMMIT_IDLE_MS 2000u
+
+// 예약된 변경을 즉시 EEPROM에 기록 (VIA id_custom_save)
+void my_config_commit(void);
+
+// 예약된 변경을 유휴 시점에 커밋 (housekeeping에서 매 루프 호출, now = timer_read32)
+void my_config_task(uint32_t now);
+
 #ifdef VIA_ENABLE
 enum custom_value_id {
     // VIA 커스텀 값: 핀별 LED 플래그 (LED_MODE_* 비트 OR 값)
@@ -20,11 +83,65 @@ enum custom_value_id {
     // VIA 커스텀 값: 핀별 인디케이터 선택(0:none,1:scroll,2:caps)
     id_custom_indicator_a6,
     id_custom_indicator_a7,
-    id_custom_indicator_b0
+    id_custom_indicator_b0,
+    // VIA 커스텀 값: 호스트 OS 고정 (enum my_host_os_override)
+    id_custom_host_os,
+    // VIA 커스텀 값: 핀별 브리딩 곡선 (enum effect_breath_curve)
+    id_custom_breath_curve_a6,
+    id_custom_breath_curve_a7,
+    id_custom_breath_curve_b0,
+    // VIA 커스텀 값: 핀별 최대 밝기
+    id_custom_brightness_a6,
+    id_custom_brightness_a7,
+    id_custom_brightness_b0,
+    // VIA 커스텀 값: 디바운스 창 (ms)
+    id_custom_debounce_ms,
+    // VIA 커스텀 값: 유휴 단계 시간
+    id_custom_idle_light_s,
+    id_custom_idle_deep_min,
+    // VIA 커스텀 값: 핀별 브리딩 위상
+    id_custom_breath_phase_a6,
+    id_custom_breath_phase_a7,
+    id_custom_breath_phase_b0
 };
+
+// 핀별 채널: LED 10 + i, 인디케이터 20 + i (i = 0..MY_LED_COUNT-1)
+#define MYFI_VIA_CHANNEL_LED_BASE       10
+#define MYFI_VIA_CHANNEL_INDICATOR_BASE 20
+_Static_assert(MY_LED_COUNT <= 10, "per-pin VIA channel ranges hold at most 10 pins");
+
+// 핀별 LED 채널의 value id
+enum my_via_led_value {
+    MYFI_VIA_LED_FLAGS = 0,
+    MYFI_VIA_LED_BREATH_CURVE,
+    MYFI_VIA_LED_BRIGHTNESS,
+    MYFI_VIA_LED_BREATH_PHASE,
+};
+
+// 채널 30: 호스트 OS 고정
+#define MYFI_VIA_CHANNEL_HOST_OS 30
+// 채널 31: 디바운스 창 (ms)
+#define MYFI_VIA_CHANNEL_DEBOUNCE 31
+// 채널 32: 유휴 단계 시간 (value id 0: 스캔 감속 초, 1: 깊은 유휴 분)
+#define MYFI_VIA_CHANNEL_IDLE 32
+
+enum my_via_idle_value {
+    MYFI_VIA_IDLE_LIGHT_S = 0,
+    MYFI_VIA_IDLE_DEEP_MIN,
+};
+
+// 채널 33: 전체 설정 일괄 get/set (프로필 백업/복원, 메뉴 열기를 패킷 하나로)
+// [command][channel][version][raw 워드 4바이트 LE][확장 레코드 본문 sizeof(my_config_ext_t)]
+// version = MY_CONFIG_EXT_VERSION. 다른 버전의 set은 적용하지 않고 id_unhandled로 돌려보냄
+// set은 두 레코드를 한 번에 바꾸고 캐시를 한 번만 다시 만든 뒤 커밋을 한 번만 예약
+// 확장 레코드의 last_os(감지 결과)는 set에서 무시하고 현재 값을 유지
+#define MYFI_VIA_CHANNEL_BULK 33
+#define MYFI_VIA_BULK_HEADER  3u // command, channel, version
+#define MYFI_VIA_BULK_SIZE    (MYFI_VIA_BULK_HEADER + sizeof(uint32_t) + sizeof(my_config_ext_t))
+_Static_assert(MYFI_VIA_BULK_SIZE <= 32u, "bulk config no longer fits in one VIA packet");
 #endif
 
-// 핀 인덱스와 동일한 순서 사용: 0:A6, 1:A7, 2:B0
+// 핀 인덱스 = LED 채널 인덱스 (config.h의 MY_LED_PINS 순서, 범위 밖 인덱스는 마지막 채널로 고정)
 uint8_t my_config_get_led_flags(uint8_t idx);
 void my_config_set_led_flags(uint8_t idx, uint8_t flags);
 
@@ -32,4 +149,30 @@ void my_config_set_led_flags(uint8_t idx, uint8_t flags);
 uint8_t my_config_get_indicator(uint8_t idx);
 void my_config_set_indicator(uint8_t idx, uint8_t indicator);
 
-// 버전 관리는 사용하지 않으므로 제거됨
+// 호스트 OS 고정 get/set (enum my_host_os_override)
+uint8_t my_config_get_host_os(void);
+void my_config_set_host_os(uint8_t host_os);
+
+// 브리딩 곡선 / 최대 밝기 / 브리딩 위상 get/set (확장 레코드)
+uint8_t my_config_get_breath_curve(uint8_t idx);
+void my_config_set_breath_curve(uint8_t idx, uint8_t curve);
+uint8_t my_config_get_brightness(uint8_t idx);
+void my_config_set_brightness(uint8_t idx, uint8_t brightness);
+uint8_t my_config_get_breath_phase(uint8_t idx);
+void my_config_set_breath_phase(uint8_t idx, uint8_t phase);
+
+// 디바운스 창 get/set (ms, 확장 레코드)
+uint8_t my_config_get_debounce(void);
+void my_config_set_debounce(uint8_t ms);
+
+// 마지막 OS 감지 결과 get/set (확장 레코드, os_variant_t). 값이 바뀔 때만 지연 저장
+uint8_t my_config_get_last_os(void);
+void my_config_set_last_os(uint8_t os);
+
+// 유휴 단계 시간 get/set (확장 레코드, 0 = 사용 안 함)
+uint8_t my_config_get_idle_light_s(void);
+void my_config_set_idle_light_s(uint8_t seconds);
+uint8_t my_config_get_idle_deep_min(void);
+void my_config_set_idle_deep_min(uint8_t minutes);
+
+// 32비트 raw 워드는 버전 없이 유지하고, 이후 설정은 버전/CRC가 있는 확장 레코드에 추가함
@@ -0,0 +1,122 @@
+// myfi: 6x18 매트릭스용 키별 eager-press / deferred-release 디바운스
+#include "my_debounce.h"
+#include "debounce.h"
+
+// 키당 상태 = 4비트 남은 시간(ms) + 릴리즈 대기 비트 (108키 기준 54 + 24 + 24 바이트)
+#define DEBOUNCE_KEY_COUNT (MATRIX_ROWS * MATRIX_COLS)
+
+static uint8_t s_countdown[(DEBOUNCE_KEY_COUNT + 1) / 2];
+static matrix_row_t s_counting[MATRIX_ROWS];        // 카운트다운 중인 키
+static matrix_row_t s_release_pending[MATRIX_ROWS]; // 뗌 확인 대기 중인 키
+static uint8_t s_window_ms = MY_DEBOUNCE_DEFAULT_MS;
+static uint16_t s_last_time;
+
+_Static_assert(MY_DEBOUNCE_MAX_MS <= 0x0Fu, "debounce countdown is stored in 4 bits");
+
+static inline uint8_t countdown_get(uint16_t key)
+{
+    const uint8_t b = s_countdown[key >> 1];
+    return (key & 1u) ? (uint8_t)(b >> 4) : (uint8_t)(b & 0x0Fu);
+}
+
+static inline void countdown_set(uint16_t key, uint8_t value)
+{
+    uint8_t* b = &s_countdown[key >> 1];
+    *b = (key & 1u) ? (uint8_t)((*b & 0x0Fu) | (value << 4)) : (uint8_t)((*b & 0xF0u) | value);
+}
+
+void my_debounce_set_window(uint8_t ms)
+{
+    s_window_ms = (ms > MY_DEBOUNCE_MAX_MS) ? MY_DEBOUNCE_MAX_MS : ms;
+    for (uint16_t key = 0; key < DEBOUNCE_KEY_COUNT; key++)
+    {
+        if (countdown_get(key) > s_window_ms) countdown_set(key, s_window_ms);
+    }
+}
+
+void debounce_init(uint8_t num_rows)
+{
+    (void)num_rows;
+    memset(s_countdown, 0, sizeof(s_countdown));
+    memset(s_counting, 0, sizeof(s_counting));
+    memset(s_release_pending, 0, sizeof(s_release_pending));
+    s_last_time = timer_read();
+}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed)
+{
+    const uint16_t now = timer_read();
+    const uint16_t elapsed16 = (uint16_t)(now - s_last_time);
+    const uint8_t elapsed = (elapsed16 > MY_DEBOUNCE_MAX_MS) ? MY_DEBOUNCE_MAX_MS : (uint8_t)elapsed16;
+    s_last_time = now;
+
+    bool cooked_changed = false;
+
+    if (s_window_ms == 0)
+    {
+        for (uint8_t row = 0; row < num_rows; row++)
+        {
+            if (cooked[row] != raw[row]) { cooked[row] = raw[row]; cooked_changed = true; }
+        }
+        return cooked_changed;
+    }
+
+    for (uint8_t row = 0; row < num_rows; row++)
+    {
+        // 카운트다운 중이거나 raw와 cooked가 다른 키만 처리 (대부분의 스캔에서 행 전체를 건너뜀)
+        const matrix_row_t diff = raw[row] ^ cooked[row];
+        const matrix_row_t active = s_counting[row] | diff | s_release_pending[row];
+        if (active == 0) continue;
+
+        uint16_t key = (uint16_t)row * MATRIX_COLS;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, key++)
+        {
+            const matrix_row_t bit = (matrix_row_t)1 << col;
+            if ((active & bit) == 0) continue;
+
+            if ((s_release_pending[row] & bit) && (diff & bit) == 0)
+            {
+                // 뗌 확인 중 다시 눌림(채터링): 대기 취소, 다음 뗌에서 창을 새로 시작
+                s_release_pending[row] &= ~bit;
+                s_counting[row] &= ~bit;
+                countdown_set(key, 0);
+                continue;
+            }
+
+            if (s_counting[row] & bit)
+            {
+                uint8_t left = countdown_get(key);
+                left = (left > elapsed) ? (uint8_t)(left - elapsed) : 0u;
+                countdown_set(key, left);
+                if (left != 0) continue;
+                s_counting[row] &= ~bit;
+            }
+
+            if ((diff & bit) == 0) continue;
+
+            if (raw[row] & bit)
+            {
+                // eager press: 잠금 창이 끝난 키는 바로 보고
+                cooked[row] |= bit;
+                cooked_changed = true;
+            }
+            else if (s_release_pending[row] & bit)
+            {
+                // 창 동안 계속 떨어져 있었음: 뗌 보고
+                s_release_pending[row] &= ~bit;
+                cooked[row] &= ~bit;
+                cooked_changed = true;
+                continue;
+            }
+            else
+            {
+                // 뗌 확인 시작 (deferred release)
+                s_release_pending[row] |= bit;
+            }
+            countdown_set(key, s_window_ms);
+            s_counting[row] |= bit;
+        }
+    }
+    (void)changed;
+    return cooked_changed;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "quantum.h"
+
+// 키별 eager-press / deferred-release 디바운스 (rules.mk: DEBOUNCE_TYPE = custom)
+// - 누름: 이전 상태가 안정적이면 바로 보고하고, 창(window) 동안 채터링 무시
+// - 뗌: 창 동안 계속 떨어져 있을 때만 보고
+// 창 길이는 VIA(채널 31)에서 런타임에 변경 (0 = 디바운스 없음)
+
+#define MY_DEBOUNCE_DEFAULT_MS 5u
+#define MY_DEBOUNCE_MAX_MS     15u // 키당 4비트 카운터
+
+// 설정 변경 시 호출 (진행 중인 카운트다운은 새 창 길이로 자름)
+void my_debounce_set_window(uint8_t ms);
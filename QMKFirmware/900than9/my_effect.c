@@ -1,37 +1,87 @@
 #include "my_effect.h"
+#include "my_config.h"
+#include "my_perf.h"
 
 static my_effect_state_t s_state;
 
+// 다음 출력 변화가 없을 때의 최대 대기 (timer_expired32 비교 범위 안에서 주기적으로 재평가)
+#define EFFECT_SCHED_MAX_WAIT_MS 60000u
+// 키가 눌려 있는 동안 매트릭스와 눌린 키 집합을 대조하는 주기
+#define EFFECT_HELD_RESYNC_MS    250u
+
 void my_effect_init(void)
 {
     s_state.any_key_held = false;
     s_state.last_typing_time = 0;
-    s_state.breathing_cycle = 0;
-    s_state.pwm_counter = 0;
+    memset(s_state.held, 0, sizeof(s_state.held));
+    s_state.held_count = 0;
+    s_state.host_leds = host_keyboard_led_state();
+    my_effect_request_update();
 }
 
 void my_effect_reset(void)
 {
     s_state.any_key_held = false;
     s_state.last_typing_time = 0;
+    memset(s_state.held, 0, sizeof(s_state.held));
+    s_state.held_count = 0;
+    my_effect_request_update();
 }
 
-static inline bool in_typing_pulse_window(uint16_t flash_ms)
+void my_effect_request_update(void)
 {
-    return (timer_elapsed32(s_state.last_typing_time) < flash_ms);
+    s_state.update_pending = true;
 }
 
-static inline uint8_t compute_breath_brightness_ease(uint16_t phase)
+void my_effect_set_host_leds(led_t leds)
 {
-    uint16_t half_cycle = EFFECT_BREATH_HALF_PERIOD;
-    uint16_t mirrored = (phase < half_cycle) ? phase : (uint16_t)(EFFECT_BREATH_PERIOD - phase);
-    // u in [0, 65535]
-    uint32_t u = ((uint32_t)mirrored << 16) / half_cycle;
-    // smoothstep: 3u^2 - 2u^3  (scaled to 16.16)
-    uint32_t u2 = (u * u) >> 16;
-    uint32_t smooth = (u2 * (((uint32_t)3 << 16) - (u << 1))) >> 16;
-    uint32_t brightness = (uint32_t)EFFECT_BREATH_BASE + (((uint32_t)EFFECT_BREATH_RANGE * smooth) >> 16);
-    return (uint8_t)brightness;
+    if (leds.raw == s_state.host_leds.raw) return;
+    s_state.host_leds = leds;
+    my_effect_request_update();
+}
+
+// --- 브리딩 파형 테이블 (컴파일 타임 생성, 플래시 상주) ---
+// u = i / N (i: 0..N) 에 대한 밝기. 런타임에는 곱셈/나눗셈 없이 조회만 수행
+#define BREATH_N ((unsigned long long)EFFECT_BREATH_TABLE_SIZE - 1u)
+#define BREATH_SCALE(num, den) \
+    (EFFECT_BREATH_BASE + (unsigned)(((unsigned long long)EFFECT_BREATH_RANGE * (num) + (den) / 2u) / (den)))
+
+// smoothstep: 3u^2 - 2u^3
+#define BREATH_SMOOTHSTEP(i) \
+    BREATH_SCALE((unsigned long long)(i) * (i) * (3u * BREATH_N - 2u * (i)), BREATH_N * BREATH_N * BREATH_N)
+
+// sine: (1 - cos(pi*u)) / 2 = sin^2(pi*u/2), sin은 Bhaskara I 근사 (오차 < 0.2%)
+#define BREATH_SIN_NUM(i) (16u * (unsigned long long)(i) * (2u * BREATH_N - (i)))
+#define BREATH_SIN_DEN(i) (20u * BREATH_N * BREATH_N - 4u * (unsigned long long)(i) * (2u * BREATH_N - (i)))
+#define BREATH_SINE(i) BREATH_SCALE(BREATH_SIN_NUM(i) * BREATH_SIN_NUM(i), BREATH_SIN_DEN(i) * BREATH_SIN_DEN(i))
+
+// triangle: u
+#define BREATH_TRIANGLE(i) BREATH_SCALE((unsigned long long)(i), BREATH_N)
+
+#define BREATH_REP4(F, i)  F(i) F((i) + 1u) F((i) + 2u) F((i) + 3u)
+#define BREATH_REP16(F, i) BREATH_REP4(F, i) BREATH_REP4(F, (i) + 4u) BREATH_REP4(F, (i) + 8u) BREATH_REP4(F, (i) + 12u)
+#define BREATH_REP64(F, i) BREATH_REP16(F, i) BREATH_REP16(F, (i) + 16u) BREATH_REP16(F, (i) + 32u) BREATH_REP16(F, (i) + 48u)
+#define BREATH_REP128(F)   BREATH_REP64(F, 0u) BREATH_REP64(F, 64u)
+
+#define BREATH_SMOOTHSTEP_ENTRY(i) (uint8_t)BREATH_SMOOTHSTEP(i),
+#define BREATH_SINE_ENTRY(i)       (uint8_t)BREATH_SINE(i),
+#define BREATH_TRIANGLE_ENTRY(i)   (uint8_t)BREATH_TRIANGLE(i),
+
+_Static_assert(EFFECT_BREATH_TABLE_SIZE == 128u, "breath table generator expects 128 entries");
+_Static_assert(EFFECT_BREATH_PERIOD_SHIFT >= 8u, "breath period must be at least 256ms");
+
+static const uint8_t s_breath_table[EFFECT_CURVE_COUNT][EFFECT_BREATH_TABLE_SIZE] = {
+    [EFFECT_CURVE_SMOOTHSTEP] = { BREATH_REP128(BREATH_SMOOTHSTEP_ENTRY) },
+    [EFFECT_CURVE_SINE]       = { BREATH_REP128(BREATH_SINE_ENTRY) },
+    [EFFECT_CURVE_TRIANGLE]   = { BREATH_REP128(BREATH_TRIANGLE_ENTRY) },
+};
+
+static inline uint8_t breath_brightness_at(uint32_t now, uint8_t curve)
+{
+    // 256 스텝 위상: 앞 절반은 상승, 뒤 절반은 테이블을 거꾸로 읽어 하강
+    uint8_t step = (uint8_t)(now >> EFFECT_BREATH_STEP_SHIFT);
+    uint8_t i = (step < EFFECT_BREATH_TABLE_SIZE) ? step : (uint8_t)(255u - step);
+    return s_breath_table[curve][i];
 }
 
 bool my_effect_requires_state_update(void)
@@ -40,152 +90,206 @@ bool my_effect_requires_state_update(void)
     return true;
 }
 
-void my_effect_update_typing_state_from_key_event(bool pressed)
+void my_effect_update_typing_state_from_key_event(keypos_t key, bool pressed)
 {
+    // 매트릭스 밖 이벤트(콤보 등)는 타이핑 시각만 갱신
+    const bool in_matrix = (key.row < MATRIX_ROWS) && (key.col < MATRIX_COLS);
+    const matrix_row_t bit = in_matrix ? ((matrix_row_t)1 << key.col) : 0;
+
     if (pressed)
     {
         s_state.last_typing_time = timer_read32();
-        s_state.any_key_held = true;
-    }
-    else
-    {
-        bool still_held = false;
-        for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+        if (in_matrix && (s_state.held[key.row] & bit) == 0)
         {
-            if (matrix_get_row(row)) { still_held = true; break; }
+            s_state.held[key.row] |= bit;
+            s_state.held_count++;
         }
-        s_state.any_key_held = still_held;
     }
+    else if (in_matrix && (s_state.held[key.row] & bit) != 0)
+    {
+        s_state.held[key.row] &= ~bit;
+        s_state.held_count--;
+    }
+    s_state.any_key_held = (s_state.held_count != 0);
+    my_effect_request_update();
 }
 
-static void update_led_effect_none(pin_t pin)
+// 릴리즈 이벤트가 누락된 경우(레이어 전환 등) 실제 매트릭스와 비교해 눌린 키 집합을 보정
+// 키가 눌려 있는 동안 스케줄러 평가 시점에만 실행되므로 키 이벤트 경로와 무관함
+static void resync_held_keys(void)
 {
-    writePinLow(pin);
+    uint8_t count = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+    {
+        if (s_state.held[row] == 0) continue;
+        s_state.held[row] &= matrix_get_row(row);
+        for (matrix_row_t bits = s_state.held[row]; bits != 0; bits &= bits - 1) count++;
+    }
+    s_state.held_count = count;
+    s_state.any_key_held = (count != 0);
 }
 
-static void update_led_effect_force_on(pin_t pin)
+static inline bool indicator_is_on(uint8_t ind)
 {
-    writePinHigh(pin);
+    if (ind == IND_SCROLL) return s_state.host_leds.scroll_lock;
+    if (ind == IND_CAPS) return s_state.host_leds.caps_lock;
+    return false;
 }
 
-static void update_led_effect_typing_hold(pin_t pin, bool invert)
+static inline uint32_t breath_next_step_in(uint32_t now)
 {
-    if (s_state.any_key_held)
-    {
-        if (invert) { writePinLow(pin); } else { writePinHigh(pin); }
-    }
-    else
-    {
-        if (invert) { writePinHigh(pin); } else { writePinLow(pin); }
-    }
+    const uint32_t step_ms = (uint32_t)1u << EFFECT_BREATH_STEP_SHIFT;
+    return step_ms - (now & (step_ms - 1u));
 }
 
-static void update_led_effect_typing_edge(pin_t pin, bool invert)
+// 핀별 최대 밝기 적용 (max = 255면 그대로)
+static inline uint8_t scale_brightness(uint8_t level, uint8_t max)
 {
-    if (in_typing_pulse_window(EFFECT_TYPING_PULSE_MS))
-    {
-        if (invert) { writePinLow(pin); } else { writePinHigh(pin); }
-    }
-    else
-    {
-        if (invert) { writePinHigh(pin); } else { writePinLow(pin); }
-    }
+    return (uint8_t)(((uint16_t)level * max + 255u) >> 8);
 }
 
-static void update_led_effect_breathing_noinput(pin_t pin, bool invert)
+uint8_t my_effect_normalize_flags(uint8_t flags)
 {
-    // 브리딩은 housekeeping에서 수행. 여기서는 자리만 유지.
-    (void)pin; (void)invert;
+    flags &= (uint8_t)(LED_MODE_TYPING_HOLD | LED_MODE_BREATHING | LED_MODE_TYPING_EDGE | LED_MODE_INVERT | LED_MODE_FORCE_ON);
+    if (flags & LED_MODE_FORCE_ON) return LED_MODE_FORCE_ON;
+    if (flags & LED_MODE_TYPING_HOLD) flags &= (uint8_t)~LED_MODE_TYPING_EDGE;
+    if ((flags & EFFECT_TYPING) == 0) flags &= (uint8_t)~LED_MODE_INVERT;
+    return flags;
 }
 
-static void update_led_effect_hold_breathing(pin_t pin, bool invert)
+uint8_t my_effect_behavior_for(uint8_t flags)
 {
-    if (s_state.any_key_held)
-    {
-        if (invert) { writePinLow(pin); } else { writePinHigh(pin); }
-    }
-    else
-    {
-        bool idle_1s = (timer_elapsed32(s_state.last_typing_time) > EFFECT_IDLE_MS);
-        if (!idle_1s)
-        {
-            if (invert) { writePinHigh(pin); } else { writePinLow(pin); }
-        }
-    }
+    const bool breath = (flags & LED_MODE_BREATHING) != 0;
+    if (flags & LED_MODE_TYPING_HOLD) return breath ? EFFECT_BEHAVIOR_HOLD_BREATH : EFFECT_BEHAVIOR_HOLD;
+    if (flags & LED_MODE_TYPING_EDGE) return breath ? EFFECT_BEHAVIOR_EDGE_BREATH : EFFECT_BEHAVIOR_EDGE;
+    return breath ? EFFECT_BEHAVIOR_BREATH : EFFECT_BEHAVIOR_STATIC;
 }
 
-static void update_led_effect_edge_breathing(pin_t pin, bool invert)
+// --- 채널 동작 핸들러 ---
+// 채널 상태를 마스크 비트로만 기록: active = 반전 전 레벨, breath = 브리딩 출력.
+// 출력은 my_effect_task가 모든 채널에 대해 (active ^ invert_mask)로 한 번에 만듦.
+// 반환값은 입력 이벤트 없이 상태가 다시 바뀔 수 있는 시점까지 남은 ms
+// (이벤트가 있어야만 바뀌는 상태면 EFFECT_SCHED_MAX_WAIT_MS, 브리딩 스텝은 task에서 따로 계산)
+typedef struct {
+    uint8_t active;
+    uint8_t breath;
+} effect_masks_t;
+
+typedef uint32_t (*effect_handler_t)(uint8_t bit, uint32_t since_typing, effect_masks_t* masks);
+
+// 타이핑 직후 유휴 판정(EFFECT_IDLE_MS) 전까지는 비활성 레벨, 이후 브리딩
+static uint32_t typed_then_breath(uint8_t bit, uint32_t since_typing, effect_masks_t* masks)
 {
-    if (in_typing_pulse_window(EFFECT_TYPING_PULSE_MS))
-    {
-        if (invert) { writePinLow(pin); } else { writePinHigh(pin); }
-    }
-    else
-    {
-        bool idle_1s = (timer_elapsed32(s_state.last_typing_time) > EFFECT_IDLE_MS);
-        if (!idle_1s)
-        {
-            if (invert) { writePinHigh(pin); } else { writePinLow(pin); }
-        }
-    }
+    if (since_typing <= EFFECT_IDLE_MS) return EFFECT_IDLE_MS + 1u - since_typing;
+    masks->breath |= bit;
+    return EFFECT_SCHED_MAX_WAIT_MS;
 }
 
-void my_effect_apply_pin_effect(pin_t pin, uint8_t mode)
+static uint32_t behavior_static(uint8_t bit, uint32_t since_typing, effect_masks_t* masks)
 {
-    if (mode == LED_MODE_FORCE_ON) { update_led_effect_force_on(pin); return; }
-    if (mode == LED_MODE_NONE)     { update_led_effect_none(pin); return; }
-
-    const bool invert = (mode & LED_MODE_INVERT) != 0;
-    const bool hold   = (mode & LED_MODE_TYPING_HOLD) != 0;
-    const bool edge   = (mode & LED_MODE_TYPING_EDGE) != 0;
-    const bool breath = (mode & LED_MODE_BREATHING) != 0;
+    return EFFECT_SCHED_MAX_WAIT_MS;
+}
 
-    if (breath && hold) { update_led_effect_hold_breathing(pin, invert); return; }
-    if (breath && edge) { update_led_effect_edge_breathing(pin, invert); return; }
-    if (breath)         { update_led_effect_breathing_noinput(pin, invert); return; }
-    if (hold)           { update_led_effect_typing_hold(pin, invert); return; }
-    if (edge)           { update_led_effect_typing_edge(pin, invert); return; }
+static uint32_t behavior_breath(uint8_t bit, uint32_t since_typing, effect_masks_t* masks)
+{
+    masks->breath |= bit;
+    return EFFECT_SCHED_MAX_WAIT_MS;
+}
 
-    writePinLow(pin);
+static uint32_t behavior_hold(uint8_t bit, uint32_t since_typing, effect_masks_t* masks)
+{
+    // 키를 놓을 때(이벤트)까지 유지
+    if (s_state.any_key_held) masks->active |= bit;
+    return EFFECT_SCHED_MAX_WAIT_MS;
 }
 
-void my_effect_update_effects_for_pin(pin_t pin, uint8_t mode, bool indicator_on)
+static uint32_t behavior_edge(uint8_t bit, uint32_t since_typing, effect_masks_t* masks)
 {
-    // 인디케이터가 켜져 있으면 이펙트 무시
-    if (indicator_on) { writePinHigh(pin); return; }
+    // 펄스가 끝날 때까지 유지
+    if (since_typing >= EFFECT_TYPING_PULSE_MS) return EFFECT_SCHED_MAX_WAIT_MS;
+    masks->active |= bit;
+    return EFFECT_TYPING_PULSE_MS - since_typing;
+}
 
-    s_state.breathing_cycle = (uint16_t)((s_state.breathing_cycle + 1) % EFFECT_BREATH_PERIOD);
-    uint16_t phase = (uint16_t)(s_state.breathing_cycle % EFFECT_BREATH_PERIOD);
-    uint8_t brightness = compute_breath_brightness_ease(phase);
+static uint32_t behavior_hold_breath(uint8_t bit, uint32_t since_typing, effect_masks_t* masks)
+{
+    if (s_state.any_key_held)
+    {
+        masks->active |= bit;
+        return EFFECT_SCHED_MAX_WAIT_MS;
+    }
+    return typed_then_breath(bit, since_typing, masks);
+}
 
-    s_state.pwm_counter = (uint8_t)(s_state.pwm_counter + EFFECT_PWM_STEP);
-    bool new_led_state = (s_state.pwm_counter < brightness);
-    const bool in_pulse = in_typing_pulse_window(EFFECT_TYPING_PULSE_MS);
-    const bool idle_1s = (timer_elapsed32(s_state.last_typing_time) > EFFECT_IDLE_MS);
+static uint32_t behavior_edge_breath(uint8_t bit, uint32_t since_typing, effect_masks_t* masks)
+{
+    if (since_typing < EFFECT_TYPING_PULSE_MS)
+    {
+        masks->active |= bit;
+        return EFFECT_TYPING_PULSE_MS - since_typing;
+    }
+    return typed_then_breath(bit, since_typing, masks);
+}
 
-    const bool breath = (mode & LED_MODE_BREATHING) != 0;
-    const bool hold   = (mode & LED_MODE_TYPING_HOLD) != 0;
-    const bool edge   = (mode & LED_MODE_TYPING_EDGE) != 0;
+static const effect_handler_t kBehaviorHandlers[EFFECT_BEHAVIOR_COUNT] = {
+    [EFFECT_BEHAVIOR_STATIC]      = behavior_static,
+    [EFFECT_BEHAVIOR_BREATH]      = behavior_breath,
+    [EFFECT_BEHAVIOR_HOLD]        = behavior_hold,
+    [EFFECT_BEHAVIOR_EDGE]        = behavior_edge,
+    [EFFECT_BEHAVIOR_HOLD_BREATH] = behavior_hold_breath,
+    [EFFECT_BEHAVIOR_EDGE_BREATH] = behavior_edge_breath,
+};
 
-    if (!breath) return;
+void my_effect_task(uint32_t now)
+{
+    // 키 이벤트/인디케이터/설정 변경이 없고 다음 변화 시점 전이면 할 일이 없음
+    if (!s_state.update_pending && !timer_expired32(now, s_state.next_update_time)) return;
+    s_state.update_pending = false;
+    MY_PERF_COUNT(MY_PERF_CNT_EFFECT_EVAL);
 
-    bool allow_breath;
-    if (!hold && !edge)
+    uint32_t wait = EFFECT_SCHED_MAX_WAIT_MS;
+    if (s_state.any_key_held)
     {
-        // 브리딩 단독일 때는 유휴 상태와 무관하게 항상 허용
-        allow_breath = true;
+        resync_held_keys();
+        wait = EFFECT_HELD_RESYNC_MS;
     }
-    else if (hold)
+
+    const my_config_cache_t* cfg = &g_my_config_cache;
+    const uint32_t since_typing = now - s_state.last_typing_time;
+
+    // 1) 채널 상태 -> 마스크. 인디케이터 ON 채널은 이펙트 무시 (꺼질 때는 my_effect_set_host_leds가 깨움)
+    effect_masks_t masks = { 0, 0 };
+    uint8_t indicator_mask = 0;
+    for (uint8_t ch = 0; ch < MY_LED_COUNT; ch++)
     {
-        allow_breath = (!s_state.any_key_held) && idle_1s;
+        const uint8_t bit = (uint8_t)(1u << ch);
+        if (indicator_is_on(cfg->indicator[ch]))
+        {
+            indicator_mask |= bit;
+            continue;
+        }
+        const uint32_t ch_wait = kBehaviorHandlers[cfg->behavior[ch]](bit, since_typing, &masks);
+        if (ch_wait < wait) wait = ch_wait;
     }
-    else /* edge */
+
+    // 2) 마스크 -> 출력. 위상 오프셋은 브리딩 스텝의 정수배라 모든 채널의 다음 스텝 시점이 같음
+    const uint8_t on_mask = (uint8_t)(((masks.active ^ cfg->invert_mask) & ~masks.breath) | indicator_mask);
+    for (uint8_t ch = 0; ch < MY_LED_COUNT; ch++)
     {
-        allow_breath = (!in_pulse) && idle_1s;
+        const uint8_t bit = (uint8_t)(1u << ch);
+        uint8_t level = (on_mask & bit) ? cfg->brightness[ch] : MY_LED_OFF;
+        if (masks.breath & bit)
+        {
+            // 하드웨어 PWM이면 듀티만 갱신, 소프트웨어 PWM이면 my_led_task가 토글
+            const uint32_t t = now + ((uint32_t)cfg->breath_phase[ch] << EFFECT_BREATH_STEP_SHIFT);
+            level = scale_brightness(breath_brightness_at(t, cfg->breath_curve[ch]), cfg->brightness[ch]);
+        }
+        my_led_set(ch, level);
     }
-
-    if (allow_breath)
+    if (masks.breath)
     {
-        if (new_led_state) { writePinHigh(pin); } else { writePinLow(pin); }
+        const uint32_t step_wait = breath_next_step_in(now);
+        if (step_wait < wait) wait = step_wait;
     }
+    s_state.next_update_time = now + wait;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "quantum.h"
+#include "my_led.h"
 
 #ifndef BIT
 #define BIT(n) (1u << (n))
@@ -19,35 +20,92 @@
 #define EFFECT_NEEDS_STATE  (EFFECT_TYPING)
 #define EFFECT_HAS(mode, flag) (((mode) & (flag)) != 0)
 
+// 핀 동작: 설정 변경 시 플래그에서 한 번 결정하고, 스캔 경로는 테이블에서 핸들러만 꺼내 호출
+// (반전/강제 켜짐은 출력 XOR 마스크로 접어 넣음)
+enum effect_behavior {
+    EFFECT_BEHAVIOR_STATIC = 0, // NONE / FORCE_ON: 고정 레벨 (= XOR 마스크)
+    EFFECT_BEHAVIOR_BREATH,
+    EFFECT_BEHAVIOR_HOLD,
+    EFFECT_BEHAVIOR_EDGE,
+    EFFECT_BEHAVIOR_HOLD_BREATH,
+    EFFECT_BEHAVIOR_EDGE_BREATH,
+    EFFECT_BEHAVIOR_COUNT
+};
+
+// VIA에서 들어온 정의되지 않은 조합을 via.json의 11개 조합 중 하나로 정규화
+// - FORCE_ON이 있으면 FORCE_ON만 남김
+// - HOLD와 EDGE가 함께 있으면 HOLD (기존 우선순위)
+// - INVERT는 HOLD/EDGE가 있을 때만 의미가 있으므로 그 외에는 제거
+uint8_t my_effect_normalize_flags(uint8_t flags);
+
+// 정규화된 플래그 -> 핀 동작 / 출력 XOR 마스크
+uint8_t my_effect_behavior_for(uint8_t flags);
+
+static inline uint8_t my_effect_invert_for(uint8_t flags)
+{
+    return (flags & (LED_MODE_INVERT | LED_MODE_FORCE_ON)) ? 1u : 0u;
+}
+
 // --- Effect timing/shape constants ---
 #define EFFECT_TYPING_PULSE_MS     33u
 #define EFFECT_IDLE_MS             1000u
-#define EFFECT_PWM_STEP            24u
-#define EFFECT_BREATH_PERIOD       16000u
-#define EFFECT_BREATH_HALF_PERIOD  8000u
 #define EFFECT_BREATH_BASE         25u
 #define EFFECT_BREATH_RANGE        230u
 
+// 브리딩 주기 = 2^EFFECT_BREATH_PERIOD_SHIFT ms (timer_read32 기준, 스캔 속도와 무관)
+// 한 주기 = 256 스텝, 반주기 128 엔트리 테이블을 미러링해서 사용
+#define EFFECT_BREATH_PERIOD_SHIFT 12u
+#define EFFECT_BREATH_STEP_SHIFT   (EFFECT_BREATH_PERIOD_SHIFT - 8u)
+#define EFFECT_BREATH_TABLE_SIZE   128u
+
+// 브리딩 파형 (my_effect.c에서 컴파일 타임에 테이블 생성)
+enum effect_breath_curve {
+    EFFECT_CURVE_SMOOTHSTEP = 0,
+    EFFECT_CURVE_SINE,
+    EFFECT_CURVE_TRIANGLE,
+    EFFECT_CURVE_COUNT
+};
+
+// 기본 파형 (핀별 파형은 확장 설정 레코드/VIA에서 변경)
+#ifndef EFFECT_BREATH_CURVE
+#define EFFECT_BREATH_CURVE EFFECT_CURVE_SMOOTHSTEP
+#endif
+
+// 인디케이터 소스 (my_config의 indicator 값과 동일: 0:none,1:scroll,2:caps)
+typedef enum {
+    IND_NONE = 0,
+    IND_SCROLL = 1,
+    IND_CAPS = 2,
+} indicator_t;
+
 // --- Module state ---
 typedef struct {
-    bool     any_key_held;
-    uint32_t last_typing_time;
-    uint16_t breathing_cycle;
-    uint8_t  pwm_counter;
+    bool         any_key_held;
+    uint8_t      held_count;          // held 비트 수 (누름/뗌 이벤트로 증감)
+    matrix_row_t held[MATRIX_ROWS];   // 이벤트 스트림 기준 눌린 키 비트셋
+    bool         update_pending;      // 키 이벤트/인디케이터/설정 변경으로 즉시 재평가 필요
+    led_t        host_leds;
+    uint32_t     last_typing_time;
+    uint32_t     next_update_time;    // 입력 없이 출력이 바뀔 수 있는 다음 시점
 } my_effect_state_t;
 
-// Initialize/reset module state
+// Initialize/reset module state (reset은 USB suspend/resume 시에도 호출)
 void my_effect_init(void);
 void my_effect_reset(void);
 
 // 키 이벤트로 타이핑 상태 업데이트가 필요한지 여부
 bool my_effect_requires_state_update(void);
 
-// 키 입력 이벤트로 타이핑 상태를 갱신
-void my_effect_update_typing_state_from_key_event(bool pressed);
+// 키 입력 이벤트로 타이핑 상태를 갱신 (누름/뗌 모두 O(1))
+void my_effect_update_typing_state_from_key_event(keypos_t key, bool pressed);
+
+// 호스트 LED(caps/scroll) 상태 변경 통지 (led_update_user에서 호출)
+void my_effect_set_host_leds(led_t leds);
 
-// 모드에 따른 이펙트를 즉시 적용 (인디케이터 OFF일 때 호출)
-void my_effect_apply_pin_effect(pin_t pin, uint8_t mode);
+// 설정 변경 등 외부 요인으로 다음 my_effect_task에서 즉시 재평가하도록 요청
+void my_effect_request_update(void);
 
-// 브리딩/PWM 등 주기 처리: 인디케이터 ON 여부를 함께 전달
-void my_effect_update_effects_for_pin(pin_t pin, uint8_t mode, bool indicator_on);
+// LED 스케줄러: 다음 변화 시점(펄스 종료, 유휴 진입, 브리딩 스텝) 전에는 타이머 비교만 하고 반환
+// housekeeping에서 매 루프 호출. now(timer_read32)는 호출자가 한 번 읽어서 넘김
+// (스케줄러는 시각을 읽지 않음. 키 이벤트 경로는 콜백에 시각이 없어 타이핑 시각을 직접 읽음)
+void my_effect_task(uint32_t now);
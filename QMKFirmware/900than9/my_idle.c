@@ -0,0 +1,57 @@
+// myfi: 입력이 없을 때 스캔 속도를 낮추고 깊은 유휴에서는 WFI로 대기
+#include "my_idle.h"
+#include "my_boot.h"
+#include "my_config.h"
+#include "my_effect.h"
+#include "my_led.h"
+
+uint8_t g_my_idle_level = MY_IDLE_ACTIVE;
+
+bool my_idle_any_key_down(void)
+{
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+    {
+        if (matrix_get_row(row)) return true;
+    }
+    return false;
+}
+
+void my_idle_task(void)
+{
+    if (g_my_idle_level == MY_IDLE_DEEP) return;
+
+    uint8_t level = MY_IDLE_ACTIVE;
+    // 키를 누른 채로 두면 입력 활동이 갱신되지 않으므로 눌린 키가 있으면 유휴로 보지 않음
+    if (!my_idle_any_key_down())
+    {
+        const uint32_t idle_ms = last_input_activity_elapsed();
+        const uint32_t deep_ms = (uint32_t)g_my_config_ext.idle_deep_min * 60000u;
+        const uint32_t light_ms = (uint32_t)g_my_config_ext.idle_light_s * 1000u;
+        if (deep_ms != 0 && idle_ms >= deep_ms)
+        {
+            level = MY_IDLE_DEEP;
+        }
+        else if (light_ms != 0 && idle_ms >= light_ms && !g_my_config_cache.has_breathing)
+        {
+            // 브리딩은 유휴일 때 동작하는 효과라 스캔을 늦추지 않음 (소프트웨어 PWM 주기 유지)
+            level = MY_IDLE_LIGHT;
+        }
+    }
+
+    if (level == MY_IDLE_DEEP && my_boot_ready())
+    {
+        // 대기 중에는 LED 효과를 돌리지 않으므로 출력을 알려진 상태(꺼짐)로 둠.
+        // 미뤄 둔 LED 초기화 전에는 PWM(TIM3)이 시작되지 않았으므로 건드리지 않음 (suspend 경로와 같음)
+        my_led_sleep();
+    }
+    g_my_idle_level = level;
+}
+
+void my_idle_wake(void)
+{
+    if (g_my_idle_level == MY_IDLE_DEEP)
+    {
+        my_effect_request_update();
+    }
+    g_my_idle_level = MY_IDLE_ACTIVE;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "quantum.h"
+
+// 유휴 단계
+// - ACTIVE: 최대 속도 스캔
+// - LIGHT : 마지막 입력 후 idle_light_s 초가 지나고 브리딩이 없으면 스캔 주기를 늦춤
+// - DEEP  : idle_deep_min 분이 지나면 LED를 끄고, 컬럼을 HIGH로 구동한 뒤 행 핀(A14/A15/B3~B6)의
+//           상승 에지(EXTI)를 기다리며 WFI. 첫 누름은 다음 스캔에서 바로 읽힘 (my_matrix.c)
+enum my_idle_level {
+    MY_IDLE_ACTIVE = 0,
+    MY_IDLE_LIGHT,
+    MY_IDLE_DEEP,
+};
+
+// 시간 설정은 확장 레코드에 저장 (0 = 해당 단계 사용 안 함)
+#define MY_IDLE_DEFAULT_LIGHT_S   30u
+#define MY_IDLE_DEFAULT_DEEP_MIN  10u
+
+// LIGHT 단계의 스캔 간격
+#define MY_IDLE_LIGHT_SCAN_MS 10u
+
+extern uint8_t g_my_idle_level;
+
+static inline uint8_t my_idle_level(void)
+{
+    return g_my_idle_level;
+}
+
+// 유휴 단계 판정 (housekeeping에서 매 루프 호출). DEEP에서 빠져나오는 것은 매트릭스 스캔이 처리
+void my_idle_task(void);
+
+// 디바운스된 매트릭스에 눌린 키가 있는지 (유휴 판정, 설정 지연 커밋 판정에 공용)
+bool my_idle_any_key_down(void);
+
+// 매트릭스 스캔이 누름(또는 EXTI)을 감지했을 때 호출: ACTIVE로 복귀하고 LED 출력을 다시 계산
+void my_idle_wake(void);
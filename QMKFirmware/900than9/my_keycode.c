@@ -1,231 +1,313 @@
 #include "my_keycode.h"
+#include "my_config.h"
+#include "my_perf.h"
 
-static inline void press_and_release(uint16_t mod)
+// 단축키 동작 종류
+enum my_shortcut_kind
 {
-    register_code(mod);
-    unregister_code(mod);
+    SC_NONE = 0, // 정의 없음 (상위 처리로 넘김)
+    SC_TAP,      // 누를 때: mods를 누른 채 keys를 순서대로 탭하고 mods 해제
+    SC_HOLD,     // 누르는 동안 mods(+keys[0]) 유지, 뗄 때 해제
+};
+
+// 커스텀 키코드 1개의 OS별 시퀀스 (플래시 상주, 항목당 4바이트)
+typedef struct {
+    uint8_t kind;
+    uint8_t mods;    // MOD_BIT() 조합
+    uint8_t keys[2]; // 기본 키코드, 0 = 없음
+} my_shortcut_t;
+
+enum my_os_index
+{
+    MY_OS_MAC = 0, // macOS 및 그 외 (OS 감지 전 포함)
+    MY_OS_WIN,
+    MY_OS_COUNT,
+};
+
+#define M_CTL MOD_BIT(KC_LCTL)
+#define M_SFT MOD_BIT(KC_LSFT)
+#define M_ALT MOD_BIT(KC_LALT)
+#define M_GUI MOD_BIT(KC_LGUI)
+#define M_RALT MOD_BIT(KC_RALT)
+
+// 한 줄 = 키코드 하나: X(키코드, 종류, mods, 키1, 키2). 특정 OS에서 쓰지 않는 키코드도 SC_NONE 줄을 둠
+// 새 단축키는 enum my_keycodes에 추가한 뒤 두 목록에 한 줄씩만 추가하면 됨
+// clang-format off
+#define MY_SHORTCUTS_WIN(X) \
+    X(GO_LEFT, SC_TAP,  M_GUI | M_CTL, KC_LEFT,  0)       \
+    X(GO_RGHT, SC_TAP,  M_GUI | M_CTL, KC_RIGHT, 0)       \
+    X(GO_UP,   SC_TAP,  M_GUI,         KC_TAB,   0)       \
+    X(WO_LEFT, SC_HOLD, M_CTL,         KC_LEFT,  0)       \
+    X(WO_RGHT, SC_HOLD, M_CTL,         KC_RIGHT, 0)       \
+    X(OS_LANG, SC_TAP,  M_RALT,        0,        0)       \
+    X(OS_PSCR, SC_TAP,  M_GUI | M_SFT, KC_S,     0)       \
+    X(MC_LCMD, SC_HOLD, M_CTL,         0,        0)       \
+    X(MC_LCTL, SC_HOLD, M_GUI,         0,        0)       \
+    X(VS_BRCK, SC_TAP,  M_CTL | M_ALT, KC_PAUS,  0)       \
+    X(VC_FLDA, SC_TAP,  M_CTL,         KC_K,     KC_0)    \
+    X(VC_UFDA, SC_TAP,  M_CTL,         KC_K,     KC_J)    \
+    X(VC_FLDR, SC_TAP,  M_CTL,         KC_K,     KC_LBRC) \
+    X(VC_UFDR, SC_TAP,  M_CTL,         KC_K,     KC_RBRC)
+
+#define MY_SHORTCUTS_MAC(X) \
+    X(GO_LEFT, SC_TAP,  M_CTL,         KC_LEFT,  0)       \
+    X(GO_RGHT, SC_TAP,  M_CTL,         KC_RIGHT, 0)       \
+    X(GO_UP,   SC_TAP,  M_CTL,         KC_UP,    0)       \
+    X(WO_LEFT, SC_HOLD, M_ALT,         KC_LEFT,  0)       \
+    X(WO_RGHT, SC_HOLD, M_ALT,         KC_RIGHT, 0)       \
+    X(OS_LANG, SC_TAP,  M_CTL,         KC_SPACE, 0)       \
+    X(OS_PSCR, SC_TAP,  M_GUI | M_SFT, KC_4,     0)       \
+    X(MC_LCMD, SC_HOLD, M_GUI,         0,        0)       \
+    X(MC_LCTL, SC_HOLD, M_CTL,         0,        0)       \
+    X(VS_BRCK, SC_TAP,  0,             KC_PAUS,  0)       \
+    X(VC_FLDA, SC_TAP,  M_GUI,         KC_K,     KC_0)    \
+    X(VC_UFDA, SC_TAP,  M_GUI,         KC_K,     KC_J)    \
+    X(VC_FLDR, SC_TAP,  M_GUI,         KC_K,     KC_LBRC) \
+    X(VC_UFDR, SC_TAP,  M_GUI,         KC_K,     KC_RBRC)
+// clang-format on
+
+#define SC_ENTRY(kc, kind, mods, k1, k2) [(kc) - QK_KB_0] = { (kind), (mods), { (k1), (k2) } },
+
+// 컴파일 타임 검사: 줄 수 == 키코드 수, 줄마다 다른 키코드 비트 -> 모든 키코드가 정확히 한 줄씩
+#define SC_ROW_COUNT(kc, ...) + 1u
+#define SC_ROW_BIT(kc, ...)   | (1ull << ((kc) - QK_KB_0))
+#define SC_ALL_BITS           ((MY_KEYCODE_COUNT == 64u) ? ~0ull : ((1ull << MY_KEYCODE_COUNT) - 1u))
+
+_Static_assert(MY_KEYCODE_COUNT <= 64u, "shortcut row check uses a 64-bit keycode mask");
+_Static_assert((0u MY_SHORTCUTS_WIN(SC_ROW_COUNT)) == MY_KEYCODE_COUNT && (0ull MY_SHORTCUTS_WIN(SC_ROW_BIT)) == SC_ALL_BITS,
+               "MY_SHORTCUTS_WIN needs exactly one row per custom keycode");
+_Static_assert((0u MY_SHORTCUTS_MAC(SC_ROW_COUNT)) == MY_KEYCODE_COUNT && (0ull MY_SHORTCUTS_MAC(SC_ROW_BIT)) == SC_ALL_BITS,
+               "MY_SHORTCUTS_MAC needs exactly one row per custom keycode");
+
+static const my_shortcut_t s_shortcuts[MY_OS_COUNT][MY_KEYCODE_COUNT] = {
+    [MY_OS_WIN] = { MY_SHORTCUTS_WIN(SC_ENTRY) },
+    [MY_OS_MAC] = { MY_SHORTCUTS_MAC(SC_ENTRY) },
+};
+
+// --- 비동기 매크로 실행기 ---
+// 단축키 시퀀스를 보고서 단위 스텝으로 링 버퍼에 넣고, housekeeping에서 USB 프레임(1ms)당 하나씩 전송
+// 매트릭스 스캔은 재생 중에도 계속 진행되고, 키 이벤트는 재생이 끝날 때까지 보류됨 (아래)
+#define MACRO_QUEUE_SIZE 16u // 2의 거듭제곱
+_Static_assert((MACRO_QUEUE_SIZE & (MACRO_QUEUE_SIZE - 1u)) == 0, "MACRO_QUEUE_SIZE must be a power of two");
+
+enum macro_op
+{
+    MACRO_PRESS = 0, // mods, key 누른 뒤 보고서 전송
+    MACRO_RELEASE,   // key, mods 뗀 뒤 보고서 전송
+};
+
+typedef struct {
+    uint8_t op;
+    uint8_t mods;
+    uint8_t key; // 0 = 없음
+} macro_step_t;
+
+static macro_step_t s_macro_queue[MACRO_QUEUE_SIZE];
+static uint8_t s_macro_head;
+static uint8_t s_macro_tail;
+static uint16_t s_macro_last_send;
+
+static inline uint8_t macro_pending(void)
+{
+    return (uint8_t)(s_macro_tail - s_macro_head);
 }
 
-static inline void press_mods_and_tap(uint16_t win_mod, uint16_t mac_mod, uint16_t key, os_variant_t host)
+static void macro_send_step(const macro_step_t* step, uint32_t now)
 {
-    if (host == OS_WINDOWS)
+    if (step->op == MACRO_PRESS)
     {
-        register_code(win_mod);
-        tap_code(key);
-        unregister_code(win_mod);
+        add_mods(step->mods);
+        if (step->key) add_key(step->key);
     }
     else
     {
-        register_code(mac_mod);
-        tap_code(key);
-        unregister_code(mac_mod);
+        if (step->key) del_key(step->key);
+        del_mods(step->mods);
     }
+    send_keyboard_report();
+    MY_PERF_COUNT(MY_PERF_CNT_MACRO_REPORT);
+    s_macro_last_send = (uint16_t)now;
 }
 
-static inline void press_word_move(bool pressed, os_variant_t host, bool move_left)
+// 큐가 가득 찬 경우에만 사용: 이전처럼 남은 스텝을 연속으로 전송
+static void macro_flush(uint32_t now)
 {
-    if (pressed)
+    while (macro_pending() != 0)
     {
-        if (host == OS_WINDOWS)
-        {
-            register_code(KC_LCTL);
-            register_code(move_left ? KC_LEFT : KC_RIGHT);
-        }
-        else
-        {
-            register_code(KC_LALT);
-            register_code(move_left ? KC_LEFT : KC_RIGHT);
-        }
-    }
-    else
-    {
-        if (host == OS_WINDOWS)
-        {
-            unregister_code(move_left ? KC_LEFT : KC_RIGHT);
-            unregister_code(KC_LCTL);
-        }
-        else
-        {
-            unregister_code(move_left ? KC_LEFT : KC_RIGHT);
-            unregister_code(KC_LALT);
-        }
+        macro_send_step(&s_macro_queue[s_macro_head++ & (MACRO_QUEUE_SIZE - 1u)], now);
     }
 }
 
-static bool send_os_language_switch(bool pressed, os_variant_t host)
+static void macro_push(uint32_t now, uint8_t op, uint8_t mods, uint8_t key)
 {
-    if (!pressed) return false;
-    if (host == OS_WINDOWS) { tap_code(KC_RALT); }
-    else { press_mods_and_tap(KC_LCTL, KC_LCTL, KC_SPACE, host); }
-    return false;
+    if (macro_pending() >= MACRO_QUEUE_SIZE) macro_flush(now);
+    macro_step_t* step = &s_macro_queue[s_macro_tail++ & (MACRO_QUEUE_SIZE - 1u)];
+    step->op = op;
+    step->mods = mods;
+    step->key = key;
 }
 
-static bool send_os_screenshot(bool pressed, os_variant_t host)
-{
-    if (!pressed) return false;
-    if (host == OS_WINDOWS)
-    {
-        register_code(KC_LGUI);
-        register_code(KC_LSFT);
-        tap_code(KC_S);
-        unregister_code(KC_LGUI);
-        unregister_code(KC_LSFT);
-    }
-    else
-    {
-        register_code(KC_LGUI);
-        register_code(KC_LSFT);
-        tap_code(KC_4);
-        unregister_code(KC_LGUI);
-        unregister_code(KC_LSFT);
-    }
-    return false;
-}
+// --- 시퀀스 재생 중 키 이벤트 보류 ---
+// 스텝의 mods는 QMK 공용 mod 상태에 들어가므로 재생 중에 다른 키를 처리하면 그 키 보고서에 단축키
+// mods가 섞임 (예: VC_FLDA 재생 중에 굴려 누른 S가 Ctrl+S로 전송). 큐가 빌 때까지 이벤트를 보관했다가
+// 도착 순서대로 process_record에 다시 넣음
+#define DEFER_QUEUE_SIZE 8u // 2의 거듭제곱
+_Static_assert((DEFER_QUEUE_SIZE & (DEFER_QUEUE_SIZE - 1u)) == 0, "DEFER_QUEUE_SIZE must be a power of two");
+
+static keyrecord_t s_deferred[DEFER_QUEUE_SIZE];
+static uint8_t s_defer_head;
+static uint8_t s_defer_tail;
+static bool s_replaying; // 보류 이벤트를 다시 넣는 중 (다시 보류하지 않음)
 
-static bool send_word_move_left(bool pressed, os_variant_t host)
+static inline uint8_t deferred_pending(void)
 {
-    press_word_move(pressed, host, true);
-    return false;
+    return (uint8_t)(s_defer_tail - s_defer_head);
 }
 
-static bool send_word_move_right(bool pressed, os_variant_t host)
+static void deferred_replay_one(void)
 {
-    press_word_move(pressed, host, false);
-    return false;
+    keyrecord_t record = s_deferred[s_defer_head++ & (DEFER_QUEUE_SIZE - 1u)];
+    s_replaying = true;
+    process_record(&record);
+    s_replaying = false;
 }
 
-static bool send_mod_left_command_or_ctrl(bool pressed, os_variant_t host)
+bool my_keycode_defer_record(keyrecord_t* record)
 {
-    if (host == OS_WINDOWS)
+    if (s_replaying || (macro_pending() == 0 && deferred_pending() == 0)) return false;
+
+    if (deferred_pending() >= DEFER_QUEUE_SIZE)
     {
-        if (pressed) register_code(KC_LCTL); else unregister_code(KC_LCTL);
+        // 보관함이 가득 차면 남은 시퀀스를 연속 전송으로 밀어내고 보류 이벤트를 모두 처리한 뒤
+        // 이번 이벤트는 바로 처리 (보류 중 단축키가 있으면 그 시퀀스도 곧바로 밀어냄)
+        const uint32_t now = timer_read32();
+        macro_flush(now);
+        while (deferred_pending() != 0)
+        {
+            deferred_replay_one();
+            macro_flush(now);
+        }
+        return false;
     }
-    else
+    s_deferred[s_defer_tail++ & (DEFER_QUEUE_SIZE - 1u)] = *record;
+    return true;
+}
+
+void my_keycode_task(uint32_t now)
+{
+    if (macro_pending() == 0)
     {
-        if (pressed) register_code(KC_LGUI); else unregister_code(KC_LGUI);
+        // 마지막 스텝을 보낸 다음 프레임부터 보류 이벤트를 처리. 단축키를 만나면 다시 재생을 기다림
+        if (deferred_pending() == 0 || s_replaying || (uint16_t)now == s_macro_last_send) return;
+        while (deferred_pending() != 0 && macro_pending() == 0)
+        {
+            deferred_replay_one();
+        }
+        return;
     }
-    return false;
+    // 같은 1ms 프레임 안에서는 보고서를 하나만 보냄 (프레임 비교는 하위 16비트로 충분)
+    if ((uint16_t)now == s_macro_last_send) return;
+    macro_send_step(&s_macro_queue[s_macro_head++ & (MACRO_QUEUE_SIZE - 1u)], now);
 }
 
-static bool send_mod_left_ctrl_or_gui(bool pressed, os_variant_t host)
+// 시퀀스를 스텝으로 변환: 보고서 수를 최소화하기 위해 mods는 첫 키와 같은 보고서에서 누르고
+// 마지막 키를 떼는 보고서에서 함께 해제함 (키 n개 탭 = 보고서 2n개)
+static void run_shortcut(const my_shortcut_t* sc, bool pressed)
 {
-    if (host == OS_WINDOWS)
+    // 키 이벤트 콜백에는 시각이 없으므로 여기서 한 번만 읽어 큐 처리 전체에 씀
+    const uint32_t now = timer_read32();
+    if (sc->kind == SC_HOLD)
     {
-        if (pressed) register_code(KC_LGUI); else unregister_code(KC_LGUI);
+        // 앞선 시퀀스가 남아 있을 수 있으므로 hold도 큐를 거쳐 순서를 보장
+        macro_push(now, pressed ? MACRO_PRESS : MACRO_RELEASE, sc->mods, sc->keys[0]);
     }
-    else
+    else if (pressed)
     {
-        if (pressed) register_code(KC_LCTL); else unregister_code(KC_LCTL);
+        if (sc->keys[0] == 0)
+        {
+            // 모디파이어 단독 탭 (예: Windows 한/영 = RAlt)
+            macro_push(now, MACRO_PRESS, sc->mods, 0);
+            macro_push(now, MACRO_RELEASE, sc->mods, 0);
+        }
+        for (uint8_t i = 0; i < sizeof(sc->keys) && sc->keys[i] != 0; i++)
+        {
+            const bool first = (i == 0);
+            const bool last = (i + 1u == sizeof(sc->keys)) || (sc->keys[i + 1u] == 0);
+            macro_push(now, MACRO_PRESS, first ? sc->mods : 0, sc->keys[i]);
+            macro_push(now, MACRO_RELEASE, last ? sc->mods : 0, sc->keys[i]);
+        }
     }
-    return false;
-}
 
-static bool send_desktop_switch_left(bool pressed, os_variant_t host)
-{
-    if (!pressed) return false;
-    if (host == OS_WINDOWS) { register_code(KC_LGUI); register_code(KC_LCTL); tap_code(KC_LEFT); unregister_code(KC_LCTL); unregister_code(KC_LGUI); }
-    else { press_mods_and_tap(KC_LCTL, KC_LCTL, KC_LEFT, host); }
-    return false;
+    // 이번 프레임이 비어 있으면 첫 보고서는 바로 전송 (지연 없음)
+    my_keycode_task(now);
 }
 
-static bool send_desktop_switch_right(bool pressed, os_variant_t host)
+// --- 호스트 OS 캐시 ---
+// OS 감지 콜백/VIA 설정 변경 때만 갱신. 키 이벤트 경로는 선택된 테이블 포인터만 사용
+static os_variant_t s_detected_os = OS_UNSURE;
+static const my_shortcut_t* s_active_shortcuts = s_shortcuts[MY_OS_MAC];
+
+void my_keycode_update_host_os(void)
 {
-    if (!pressed) return false;
-    if (host == OS_WINDOWS) { register_code(KC_LGUI); register_code(KC_LCTL); tap_code(KC_RIGHT); unregister_code(KC_LCTL); unregister_code(KC_LGUI); }
-    else { press_mods_and_tap(KC_LCTL, KC_LCTL, KC_RIGHT, host); }
-    return false;
+    bool windows;
+    switch (g_my_config_cache.host_os)
+    {
+        case MY_HOST_OS_WINDOWS: windows = true; break;
+        case MY_HOST_OS_MACOS:   windows = false; break;
+        default:
+            // 감지 전(부팅 직후, KVM 전환 직후)에는 마지막으로 감지된 OS를 사용
+            windows = ((s_detected_os != OS_UNSURE) ? s_detected_os : my_config_get_last_os()) == OS_WINDOWS;
+            break;
+    }
+    s_active_shortcuts = s_shortcuts[windows ? MY_OS_WIN : MY_OS_MAC];
 }
 
-static bool send_desktop_overview(bool pressed, os_variant_t host)
+void my_keycode_set_detected_os(os_variant_t os)
 {
-    if (!pressed) return false;
-    if (host == OS_WINDOWS) { register_code(KC_LGUI); tap_code(KC_TAB); unregister_code(KC_LGUI); }
-    else { press_mods_and_tap(KC_LCTL, KC_LCTL, KC_UP, host); }
-    return false;
+    if (os == s_detected_os) return;
+    s_detected_os = os;
+    my_config_set_last_os(os);
+    my_keycode_update_host_os();
 }
 
-static bool send_visual_studio_toggle_breakpoint(bool pressed, os_variant_t host)
+bool process_my_custom_keycodes(uint16_t keycode, bool pressed)
 {
-    if (!pressed) return false;
-    if (host == OS_WINDOWS)
-    {
-        register_code(KC_LCTL);
-        register_code(KC_LALT);
-        tap_code(KC_PAUS);
-        unregister_code(KC_LALT);
-        unregister_code(KC_LCTL);
-    }
-    else
-    {
-        tap_code(KC_PAUS);
-    }
+    // 커스텀 범위 밖의 일반 키코드는 비교 한 번으로 통과
+    const uint16_t index = (uint16_t)(keycode - QK_KB_0);
+    if (index >= MY_KEYCODE_COUNT) return true;
+
+    const my_shortcut_t* sc = &s_active_shortcuts[index];
+    if (sc->kind == SC_NONE) return true;
+
+    run_shortcut(sc, pressed);
     return false;
 }
 
-static inline bool send_vscode_chord(bool pressed, os_variant_t host, uint16_t chord_key)
+bool my_keycode_expected_report(uint16_t keycode, uint8_t* mods, uint8_t* key)
 {
-    if (!pressed) return false;
-    if (host == OS_WINDOWS)
+    *mods = 0;
+    *key = 0;
+    if (IS_MODIFIER_KEYCODE(keycode))
     {
-        register_code(KC_LCTL);
-        tap_code(KC_K);
-        tap_code(chord_key);
-        unregister_code(KC_LCTL);
+        *mods = MOD_BIT(keycode);
+        return true;
     }
-    else
+    if (IS_BASIC_KEYCODE(keycode))
     {
-        register_code(KC_LGUI);
-        tap_code(KC_K);
-        tap_code(chord_key);
-        unregister_code(KC_LGUI);
+        *key = (uint8_t)keycode;
+        return true;
     }
-    return false;
-}
-
-static bool send_vscode_fold_all(bool pressed, os_variant_t host)      { return send_vscode_chord(pressed, host, KC_0); }
-static bool send_vscode_unfold_all(bool pressed, os_variant_t host)    { return send_vscode_chord(pressed, host, KC_J); }
-static bool send_vscode_fold_recursive(bool pressed, os_variant_t host){ return send_vscode_chord(pressed, host, KC_LBRC); }
-static bool send_vscode_unfold_recursive(bool pressed, os_variant_t host){ return send_vscode_chord(pressed, host, KC_RBRC); }
-
-typedef bool (*key_handler_t)(bool pressed, os_variant_t host);
-
-typedef struct {
-    uint16_t keycode;
-    key_handler_t handler;
-} key_handler_entry_t;
-
-static const key_handler_entry_t s_key_handlers[] = {
-    { OS_LANG, send_os_language_switch },
-    { OS_PSCR, send_os_screenshot },
-    { WO_LEFT, send_word_move_left },
-    { WO_RGHT, send_word_move_right },
-    { MC_LCMD, send_mod_left_command_or_ctrl },
-    { MC_LCTL, send_mod_left_ctrl_or_gui },
-    { GO_LEFT, send_desktop_switch_left },
-    { GO_RGHT, send_desktop_switch_right },
-    { GO_UP,   send_desktop_overview },
-    { VS_BRCK, send_visual_studio_toggle_breakpoint },
-    { VC_FLDA, send_vscode_fold_all },
-    { VC_UFDA, send_vscode_unfold_all },
-    { VC_FLDR, send_vscode_fold_recursive },
-    { VC_UFDR, send_vscode_unfold_recursive },
-};
-
-static inline key_handler_t find_key_handler(uint16_t kc)
-{
-    for (size_t i = 0; i < sizeof(s_key_handlers) / sizeof(s_key_handlers[0]); i++)
+    if (IS_QK_MODS(keycode))
     {
-        if (s_key_handlers[i].keycode == kc) return s_key_handlers[i].handler;
+        *key = QK_MODS_GET_BASIC_KEYCODE(keycode);
+        return IS_BASIC_KEYCODE(*key);
     }
-    return NULL;
-}
 
-bool process_my_custom_keycodes(uint16_t keycode, bool pressed, os_variant_t host)
-{
-    key_handler_t handler = find_key_handler(keycode);
-    if (handler != NULL)
-    {
-        return handler(pressed, host);
-    }
-    return true;
+    const uint16_t index = (uint16_t)(keycode - QK_KB_0);
+    if (index >= MY_KEYCODE_COUNT) return false;
+    const my_shortcut_t* sc = &s_active_shortcuts[index];
+    if (sc->kind == SC_NONE) return false;
+    *mods = sc->mods;
+    *key = sc->keys[0];
+    return *mods != 0 || *key != 0;
 }
@@ -85,7 +85,31 @@ enum my_keycodes
     VC_UFDA, // visual studio code unfold all
     VC_FLDR, // visual studio code fold recursive
     VC_UFDR, // visual studio code unfold recursive
+
+    MY_KEYCODE_END, // 마지막 커스텀 키코드 다음 (범위 검사/테이블 크기용)
 };
 
+#define MY_KEYCODE_COUNT (MY_KEYCODE_END - QK_KB_0)
+
 // 핸들러 진입점: 처리했다면 false 반환(상위 처리 중단), 미처리면 true 반환
-bool process_my_custom_keycodes(uint16_t keycode, bool pressed, os_variant_t host);
+// OS별 동작은 my_keycode_update_host_os에서 미리 선택된 테이블을 사용
+bool process_my_custom_keycodes(uint16_t keycode, bool pressed);
+
+// OS 감지 콜백에서 호출: 감지 결과 캐시 후 유효 OS 재선택
+void my_keycode_set_detected_os(os_variant_t os);
+
+// 감지 결과와 VIA 고정값(g_my_config_cache.host_os)으로 유효 OS와 단축키 테이블을 다시 선택
+void my_keycode_update_host_os(void);
+
+// 누름 하나가 보고서에 처음 나타나는 모양 (지연 계측용): 기본 키/모디파이어 조합은 key,
+// 모디파이어 단독은 mods, 커스텀 단축키는 첫 스텝의 mods/key. 레이어·탭-홀드 키처럼
+// 누름만으로 보고서가 정해지지 않으면 false
+bool my_keycode_expected_report(uint16_t keycode, uint8_t* mods, uint8_t* key);
+
+// process_record_user 맨 앞에서 호출: 단축키 시퀀스 재생 중이면 이벤트를 보관하고 true 반환
+// (호출자는 false를 반환해 처리 중단). 재생이 끝나면 my_keycode_task가 process_record로 다시 넣음
+bool my_keycode_defer_record(keyrecord_t* record);
+
+// 대기 중인 단축키 보고서를 USB 프레임당 하나씩 전송하고, 큐가 비면 보류한 키 이벤트를 처리
+// (housekeeping에서 매 루프 호출, now = timer_read32)
+void my_keycode_task(uint32_t now);
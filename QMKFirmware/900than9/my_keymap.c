@@ -0,0 +1,160 @@
+// myfi: 동적 키맵 조회 결과를 레이어별로 RAM에 캐시
+#include "my_keymap.h"
+#include "keymap_introspection.h"
+
+uint16_t my_keymap_sparse_keycode(const my_keymap_sparse_layer_t *layer, uint8_t row, uint8_t col)
+{
+    for (uint8_t i = 0; i < layer->count; i++)
+    {
+        const my_keymap_override_t *o = &layer->overrides[i];
+        if (o->row == row && o->col == col) return o->keycode;
+    }
+    return layer->fill;
+}
+
+#ifdef VIA_ENABLE
+#include "dynamic_keymap.h"
+#include "raw_hid.h"
+
+_Static_assert(MYFI_KEYCODE_CACHE_LAYERS <= DYNAMIC_KEYMAP_LAYER_COUNT, "MYFI_KEYCODE_CACHE_LAYERS exceeds DYNAMIC_KEYMAP_LAYER_COUNT");
+
+#define KEYMAP_LAYER_BYTES (MATRIX_ROWS * MATRIX_COLS * 2u)
+
+// 기본 키맵의 (layer, row, col): 레이어 0은 keymaps[], 그 위는 희소 목록, 나머지는 KC_TRNS
+static uint16_t default_keycode(uint8_t layer, uint8_t row, uint8_t col)
+{
+    if (layer >= 1u && layer <= g_my_sparse_layer_count)
+    {
+        return my_keymap_sparse_keycode(&g_my_sparse_layers[layer - 1u], row, col);
+    }
+    return keycode_at_keymap_location_raw(layer, row, col);
+}
+
+// 레이어 하나를 RAM에서 펼쳐 dynamic_keymap_set_buffer 한 번으로 기록 (빅 엔디언, VIA 버퍼 형식).
+// set_buffer는 eeprom_update_byte로 쓰므로 이미 같은 바이트는 다시 쓰지 않음
+static void write_default_layer(uint8_t layer)
+{
+    uint8_t buffer[KEYMAP_LAYER_BYTES];
+    uint8_t *p = buffer;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+    {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++)
+        {
+            const uint16_t keycode = default_keycode(layer, row, col);
+            *p++ = (uint8_t)(keycode >> 8);
+            *p++ = (uint8_t)keycode;
+        }
+    }
+    dynamic_keymap_set_buffer((uint16_t)(layer * KEYMAP_LAYER_BYTES), KEYMAP_LAYER_BYTES, buffer);
+}
+
+void my_keymap_seed_sparse_layers(void)
+{
+    for (uint8_t layer = 1; layer <= g_my_sparse_layer_count && layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++)
+    {
+        write_default_layer(layer);
+    }
+    my_keymap_cache_invalidate();
+}
+
+// dynamic_keymap_reset 대신 사용: 모든 레이어를 최종 기본값으로 한 번씩만 기록
+// (리셋이 레이어 1~3에 KC_TRNS를 쓴 뒤 희소 레이어로 다시 덮어쓰는 이중 기록을 피함)
+static void my_keymap_reset(void)
+{
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++)
+    {
+        write_default_layer(layer);
+    }
+    my_keymap_cache_invalidate();
+}
+
+// QMK eeconfig_init_via와 같은 순서. 키맵 리셋만 my_keymap_reset으로 바꿈 (이 보드는 인코더 맵 없음)
+static void my_keymap_init_via(void)
+{
+    via_eeprom_set_valid(false);
+    via_set_layout_options(VIA_EEPROM_LAYOUT_OPTIONS_DEFAULT);
+    my_keymap_reset();
+    dynamic_keymap_macro_reset();
+    via_eeprom_set_valid(true);
+}
+
+// via_init은 이 훅 다음에 VIA 영역이 무효하면 eeconfig_init_via(= dynamic_keymap_reset)를 부름.
+// 여기서 먼저 초기화해 두면 via_init은 유효한 영역으로 보고 넘어감
+void via_init_kb(void)
+{
+    if (via_eeprom_is_valid()) return;
+    my_keymap_init_via();
+}
+
+#if MYFI_KEYCODE_CACHE_LAYERS > 0
+
+// 칸마다 키코드 + 1을 저장하고 0을 빈 칸으로 씀 (.bss 초기값이 곧 빈 캐시).
+// 0xFFFF는 0으로 접혀 매번 EEPROM에서 읽게 될 뿐 결과는 같음
+static uint16_t s_keycode_cache[MYFI_KEYCODE_CACHE_LAYERS][MATRIX_ROWS][MATRIX_COLS];
+
+void my_keymap_cache_invalidate(void)
+{
+    memset(s_keycode_cache, 0, sizeof(s_keycode_cache));
+}
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key)
+{
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) return KC_NO;
+    if (layer >= MYFI_KEYCODE_CACHE_LAYERS) return keycode_at_keymap_location(layer, key.row, key.col);
+
+    uint16_t *slot = &s_keycode_cache[layer][key.row][key.col];
+    if (*slot == 0)
+    {
+        *slot = (uint16_t)(keycode_at_keymap_location(layer, key.row, key.col) + 1u);
+    }
+    return (uint16_t)(*slot - 1u);
+}
+
+#else
+
+void my_keymap_cache_invalidate(void) {}
+
+#endif
+
+// 키맵 쓰기는 엿보기만 하고(false 반환) VIA에 맡김. 쓰기 직후 조회는 같은 루프에서 VIA 처리가
+// 끝난 뒤이므로 비워 두기만 하면 새 값이 채워짐. 리셋 두 가지는 희소 레이어까지 한 번에 기록하도록 여기서 처리
+bool via_command_kb(uint8_t *data, uint8_t length)
+{
+    switch (data[0])
+    {
+        case id_dynamic_keymap_reset:
+            my_keymap_reset();
+            raw_hid_send(data, length);
+            return true;
+        case id_eeprom_reset:
+            my_keymap_init_via();
+            raw_hid_send(data, length);
+            return true;
+        case id_dynamic_keymap_set_keycode:
+        case id_dynamic_keymap_set_buffer:
+            my_keymap_cache_invalidate();
+            break;
+        default:
+            break;
+    }
+    return false;
+}
+
+#else
+
+void my_keymap_seed_sparse_layers(void) {}
+
+void my_keymap_cache_invalidate(void) {}
+
+// 동적 키맵이 없으면 keymaps[]에는 레이어 0만 있으므로 위 레이어는 희소 목록에서 바로 읽음
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key)
+{
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) return KC_NO;
+    if (layer >= 1u && layer <= g_my_sparse_layer_count)
+    {
+        return my_keymap_sparse_keycode(&g_my_sparse_layers[layer - 1u], key.row, key.col);
+    }
+    return keycode_at_keymap_location(layer, key.row, key.col);
+}
+
+#endif
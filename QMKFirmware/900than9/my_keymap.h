@@ -0,0 +1,47 @@
+#pragma once
+
+#include "quantum.h"
+
+// 레이어별 키코드 RAM 캐시 (VIA 동적 키맵)
+// QMK는 키 이벤트마다 활성 레이어를 위에서부터 훑으며 keymap_key_to_keycode()를 부르고,
+// VIA에서는 그때마다 에뮬레이트 EEPROM을 읽음. 위치별 키코드를 처음 읽을 때 RAM에 채워 두고
+// 이후에는 배열 한 번 읽기로 끝냄. 레이어별로 저장하므로 layer_state 변경 시 비울 필요가 없고,
+// VIA 키맵 쓰기(set_keycode / set_buffer / reset / eeprom_reset)에서만 무효화
+//
+// RAM 사용량: MYFI_KEYCODE_CACHE_LAYERS * MATRIX_ROWS * MATRIX_COLS * 2 바이트 (레이어당 216B)
+// 이 값보다 높은 레이어는 캐시 없이 EEPROM에서 읽음. 0이면 캐시를 쓰지 않음
+#ifndef MYFI_KEYCODE_CACHE_LAYERS
+#    define MYFI_KEYCODE_CACHE_LAYERS DYNAMIC_KEYMAP_LAYER_COUNT
+#endif
+
+// --- 기본 키맵의 희소 표현 ---
+// 레이어 0만 keymaps[]에 조밀하게 두고, 그 위 레이어는 채우기 키코드 + 덮어쓸 위치 목록으로 저장.
+// dynamic_keymap_reset은 keymaps[]에 있는 레이어만 채우고 나머지는 KC_TRNS로 두므로,
+// 보드가 다루는 리셋 경로(via_init_kb, VIA 키맵 리셋 / EEPROM 리셋)는 이를 부르지 않고 레이어마다
+// 최종 기본값을 RAM에서 펼쳐 dynamic_keymap_set_buffer로 한 번씩만 기록함
+typedef struct {
+    uint8_t  row;
+    uint8_t  col;
+    uint16_t keycode;
+} my_keymap_override_t;
+
+typedef struct {
+    uint16_t                    fill;      // 목록에 없는 칸의 키코드
+    uint8_t                     count;
+    const my_keymap_override_t *overrides;
+} my_keymap_sparse_layer_t;
+
+// 희소 레이어의 (row, col) 키코드
+uint16_t my_keymap_sparse_keycode(const my_keymap_sparse_layer_t *layer, uint8_t row, uint8_t col);
+
+// 키맵(keymap.c)이 정의: g_my_sparse_layers[i] = 레이어 i + 1
+extern const my_keymap_sparse_layer_t g_my_sparse_layers[];
+extern const uint8_t g_my_sparse_layer_count;
+
+// 희소 레이어를 동적 키맵에 기록 (레이어마다 set_buffer 한 번). QMK가 dynamic_keymap_reset을 직접
+// 부르는 eeconfig_init_quantum 뒤(eeconfig_init_kb)에서 호출됨. VIA가 없으면 할 일 없음
+void my_keymap_seed_sparse_layers(void);
+
+// 캐시 전체를 비움 (다음 조회 때 다시 채워짐). 캐시는 키코드 + 1을 저장해 0이 빈 칸이므로
+// 부팅 직후의 .bss는 그대로 빈 캐시이고, 초기화 훅에서 따로 부를 필요 없음
+void my_keymap_cache_invalidate(void);
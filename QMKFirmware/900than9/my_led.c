@@ -0,0 +1,151 @@
+// myfi: LED 출력 드라이버 (TIM3 하드웨어 PWM / 소프트웨어 PWM 폴백), 채널 정의는 config.h
+#include "my_led.h"
+#include "my_perf.h"
+
+static const pin_t kLedPins[MY_LED_COUNT] = MY_LED_PINS;
+
+static uint8_t s_brightness[MY_LED_COUNT];
+
+// 감마 테이블: CIE 1931 명도(L*) -> 휘도(Y). L* = i * 100 / 255,
+// Y = ((L* + 16) / 116)^3 (L* > 8), L* / 903.3 (그 외). 다항식이라 컴파일 타임 상수식으로 생성됨
+#define LED_CIE_L(i)      ((double)(i) * 100.0 / 255.0)
+#define LED_CIE_T(i)      ((LED_CIE_L(i) + 16.0) / 116.0)
+#define LED_CIE_Y(i)      ((LED_CIE_L(i) > 8.0) ? (LED_CIE_T(i) * LED_CIE_T(i) * LED_CIE_T(i)) : (LED_CIE_L(i) / 903.3))
+#define LED_GAMMA_ENTRY(i) (uint16_t)(LED_CIE_Y(i) * (double)MY_LED_DUTY_MAX + 0.5),
+
+#define LED_REP4(F, i)   F(i) F((i) + 1u) F((i) + 2u) F((i) + 3u)
+#define LED_REP16(F, i)  LED_REP4(F, i) LED_REP4(F, (i) + 4u) LED_REP4(F, (i) + 8u) LED_REP4(F, (i) + 12u)
+#define LED_REP64(F, i)  LED_REP16(F, i) LED_REP16(F, (i) + 16u) LED_REP16(F, (i) + 32u) LED_REP16(F, (i) + 48u)
+#define LED_REP256(F)    LED_REP64(F, 0u) LED_REP64(F, 64u) LED_REP64(F, 128u) LED_REP64(F, 192u)
+
+static const uint16_t kLedGamma[256] = { LED_REP256(LED_GAMMA_ENTRY) };
+
+#ifdef MYFI_LED_DRIVER_PWM
+#include <hal.h>
+
+// TIM3: 48MHz 카운트, 주기 4096 -> 약 11.7kHz
+// 폭(width) = 감마 테이블 듀티: 0 = 항상 꺼짐, MY_LED_DUTY_MAX = 항상 켜짐
+#define MY_LED_PWM_DRIVER    PWMD3
+#define MY_LED_PWM_PAL_MODE  1
+#define MY_LED_PWM_FREQUENCY 48000000
+#define MY_LED_PWM_PERIOD    MY_LED_DUTY_MAX
+
+static const pwmchannel_t kLedPwmChannels[MY_LED_COUNT] = MY_LED_PWM_CHANNELS;
+
+// 사용하는 채널만 my_led_init에서 ACTIVE_HIGH로 켬 (나머지는 DISABLED)
+static PWMConfig s_pwm_config = {
+    .frequency = MY_LED_PWM_FREQUENCY,
+    .period    = MY_LED_PWM_PERIOD,
+    .callback  = NULL,
+};
+
+void my_led_init(void)
+{
+    for (uint8_t i = 0; i < MY_LED_COUNT; i++)
+    {
+        palSetLineMode(kLedPins[i], PAL_MODE_ALTERNATE(MY_LED_PWM_PAL_MODE));
+        s_pwm_config.channels[kLedPwmChannels[i]].mode = PWM_OUTPUT_ACTIVE_HIGH;
+        s_brightness[i] = MY_LED_OFF;
+    }
+    pwmStart(&MY_LED_PWM_DRIVER, &s_pwm_config);
+    for (uint8_t i = 0; i < MY_LED_COUNT; i++)
+    {
+        pwmEnableChannel(&MY_LED_PWM_DRIVER, kLedPwmChannels[i], MY_LED_OFF);
+    }
+}
+
+void my_led_set(uint8_t idx, uint8_t brightness)
+{
+    if (idx >= MY_LED_COUNT || s_brightness[idx] == brightness) return;
+    s_brightness[idx] = brightness;
+    // 듀티 레지스터 갱신만으로 출력이 유지되므로 이후 루프에서 할 일이 없음
+    pwmEnableChannel(&MY_LED_PWM_DRIVER, kLedPwmChannels[idx], kLedGamma[brightness]);
+    MY_PERF_COUNT(MY_PERF_CNT_PIN_WRITE);
+}
+
+void my_led_sleep(void)
+{
+    for (uint8_t i = 0; i < MY_LED_COUNT; i++)
+    {
+        // 채널은 켜 둔 채 듀티 0: AF 핀이 LOW로 고정됨
+        pwmEnableChannel(&MY_LED_PWM_DRIVER, kLedPwmChannels[i], MY_LED_OFF);
+        s_brightness[i] = MY_LED_OFF;
+    }
+}
+
+void my_led_task(void)
+{
+}
+
+#else // 소프트웨어 PWM
+
+// 1차 시그마-델타 변조기: 채널마다 듀티를 누산해 넘칠 때만 켬.
+// 고정 카운터 비교보다 켜짐/꺼짐이 고르게 흩어져 저밝기에서 깜빡임이 적음
+static uint16_t s_sd_acc[MY_LED_COUNT];
+// 중간 밝기(0/255가 아닌 값)라서 매 루프 변조가 필요한 채널 비트
+static uint8_t s_soft_pwm_mask;
+
+void my_led_init(void)
+{
+    for (uint8_t i = 0; i < MY_LED_COUNT; i++)
+    {
+        setPinOutput(kLedPins[i]);
+        writePinLow(kLedPins[i]);
+        s_brightness[i] = MY_LED_OFF;
+        s_sd_acc[i] = 0;
+    }
+    s_soft_pwm_mask = 0;
+}
+
+void my_led_set(uint8_t idx, uint8_t brightness)
+{
+    if (idx >= MY_LED_COUNT || s_brightness[idx] == brightness) return;
+    s_brightness[idx] = brightness;
+
+    if (brightness == MY_LED_OFF || brightness == MY_LED_FULL)
+    {
+        s_soft_pwm_mask &= (uint8_t)~BIT(idx);
+        if (brightness == MY_LED_FULL) { writePinHigh(kLedPins[idx]); } else { writePinLow(kLedPins[idx]); }
+        MY_PERF_COUNT(MY_PERF_CNT_PIN_WRITE);
+    }
+    else
+    {
+        s_soft_pwm_mask |= (uint8_t)BIT(idx);
+    }
+}
+
+void my_led_sleep(void)
+{
+    for (uint8_t i = 0; i < MY_LED_COUNT; i++)
+    {
+        writePinLow(kLedPins[i]);
+        s_brightness[i] = MY_LED_OFF;
+        s_sd_acc[i] = 0;
+    }
+    s_soft_pwm_mask = 0;
+}
+
+void my_led_task(void)
+{
+    if (s_soft_pwm_mask == 0) return;
+
+    for (uint8_t i = 0; i < MY_LED_COUNT; i++)
+    {
+        if ((s_soft_pwm_mask & BIT(i)) == 0) continue;
+        // 누산기 < MY_LED_DUTY_MAX 유지, 듀티 <= MY_LED_DUTY_MAX 이므로 합은 uint16 안에 들어감
+        uint16_t acc = (uint16_t)(s_sd_acc[i] + kLedGamma[s_brightness[i]]);
+        if (acc >= MY_LED_DUTY_MAX)
+        {
+            s_sd_acc[i] = (uint16_t)(acc - MY_LED_DUTY_MAX);
+            writePinHigh(kLedPins[i]);
+        }
+        else
+        {
+            s_sd_acc[i] = acc;
+            writePinLow(kLedPins[i]);
+        }
+        MY_PERF_COUNT(MY_PERF_CNT_PIN_WRITE);
+    }
+}
+
+#endif
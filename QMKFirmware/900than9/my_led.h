@@ -0,0 +1,44 @@
+#pragma once
+
+#include "quantum.h"
+
+#ifndef BIT
+#define BIT(n) (1u << (n))
+#endif
+
+// LED 출력 드라이버
+// - MYFI_LED_DRIVER_PWM 정의 시: TIM3 하드웨어 PWM (A6=CH1, A7=CH2, B0=CH3)
+// - 미정의 시: GPIO 소프트웨어 PWM (housekeeping에서 my_led_task 호출 필요)
+
+// 채널 수와 핀은 config.h (MY_LED_COUNT, MY_LED_PINS). 이 보드: 0:A6(ESC), 1:A7(SCROLL), 2:B0(CAPS)
+#ifndef MY_LED_COUNT
+#error "MY_LED_COUNT / MY_LED_PINS must be defined in config.h"
+#endif
+
+// 채널별 상태는 8비트 마스크로도 다루므로 8채널까지
+_Static_assert(MY_LED_COUNT >= 1 && MY_LED_COUNT <= 8, "MY_LED_COUNT must be 1..8");
+
+#define MY_LED_OFF  0u
+#define MY_LED_FULL 255u
+
+// 밝기(0..255, 지각 밝기) -> 듀티(0..MY_LED_DUTY_MAX, 선형 광량) 감마 테이블 해상도.
+// 하드웨어 PWM 주기와 소프트웨어 시그마-델타 누산기가 모두 이 단위를 씀
+#define MY_LED_DUTY_BITS 12u
+#define MY_LED_DUTY_MAX  (1u << MY_LED_DUTY_BITS)
+
+void my_led_init(void);
+
+// 채널 밝기 설정 (0..255, 감마 보정 후 출력). 이전 값과 같으면 아무 것도 하지 않음
+void my_led_set(uint8_t idx, uint8_t brightness);
+
+// 모든 출력을 끄고 기억한 밝기도 꺼짐으로 맞춤 (깊은 유휴, USB suspend).
+// 깨어난 뒤 my_effect_request_update로 다시 계산해서 복구
+void my_led_sleep(void);
+
+// 소프트웨어 PWM 주기 처리. 하드웨어 PWM 빌드에서는 아무 일도 하지 않음
+void my_led_task(void);
+
+static inline void my_led_write(uint8_t idx, bool on)
+{
+    my_led_set(idx, on ? MY_LED_FULL : MY_LED_OFF);
+}
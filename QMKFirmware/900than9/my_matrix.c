@@ -0,0 +1,207 @@
+// myfi: 6x18 COL2ROW 매트릭스 스캔 (rules.mk: CUSTOM_MATRIX = lite)
+// 기본 스캐너는 행마다 컬럼 18개를 readPin으로 하나씩 읽음. 여기서는 컬럼이 걸쳐 있는
+// 포트(B/A/F/C)의 IDR을 행마다 한 번씩만 읽고, 미리 만든 포트/비트 테이블로 행 비트맵을 조립함
+#include "quantum.h"
+#include "matrix.h"
+#include "my_perf.h"
+#include "my_idle.h"
+
+// 컬럼이 걸쳐 있는 GPIO 포트 수 상한 (이 보드는 B/A/F/C 4개)
+#define MY_MATRIX_PORT_MAX 4
+
+// 행 해제 후 컬럼이 HIGH로 돌아올 때까지 폴링하는 최대 횟수 (고정 지연 대신 사용)
+#define MY_MATRIX_SETTLE_MAX_LOOPS 160u
+
+static const pin_t kRowPins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t kColPins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+// 컬럼 핀 정의에서 만든 포트/비트 테이블 (핀 정의가 포트 주소 캐스트라 C 상수식으로는 분해할 수 없어 init에서 한 번 생성)
+static ioportid_t s_ports[MY_MATRIX_PORT_MAX];
+static ioportmask_t s_port_masks[MY_MATRIX_PORT_MAX]; // 포트별 컬럼 핀 마스크
+static uint8_t s_port_count;
+static uint8_t s_col_port[MATRIX_COLS];               // 컬럼 -> s_ports 인덱스
+static uint8_t s_col_pad[MATRIX_COLS];                // 컬럼 -> 포트 내 비트 번호
+
+// 유휴 단계 상태
+static uint16_t s_last_scan_ms;      // LIGHT 단계 스캔 간격 판정용
+static bool s_wake_armed;            // DEEP: 컬럼 구동 + 행 EXTI 활성 상태
+static volatile bool s_wake_event;   // DEEP: 행 핀 상승 에지 발생 (EXTI 콜백)
+
+_Static_assert(MATRIX_COLS <= sizeof(matrix_row_t) * 8, "matrix_row_t too small for MATRIX_COLS");
+
+static uint8_t port_index(ioportid_t port)
+{
+    for (uint8_t p = 0; p < s_port_count; p++)
+    {
+        if (s_ports[p] == port) return p;
+    }
+    // 상한을 넘는 핀 정의는 빌드 설정 오류: 마지막 포트로 묶어 읽기만 틀어지게 둠
+    if (s_port_count == MY_MATRIX_PORT_MAX) return MY_MATRIX_PORT_MAX - 1;
+    s_ports[s_port_count] = port;
+    return s_port_count++;
+}
+
+// 컬럼 핀이 모두 HIGH로 돌아올 때까지 대기 (눌린 키가 있던 행 다음에만 필요)
+static inline void wait_cols_high(void)
+{
+    for (uint16_t loop = 0; loop < MY_MATRIX_SETTLE_MAX_LOOPS; loop++)
+    {
+        bool settled = true;
+        for (uint8_t p = 0; p < s_port_count; p++)
+        {
+            if ((palReadPort(s_ports[p]) & s_port_masks[p]) != s_port_masks[p]) { settled = false; break; }
+        }
+        if (settled) return;
+    }
+}
+
+static inline matrix_row_t read_cols(void)
+{
+    ioportmask_t low[MY_MATRIX_PORT_MAX];
+    for (uint8_t p = 0; p < s_port_count; p++)
+    {
+        low[p] = ~palReadPort(s_ports[p]); // 눌린 키 = LOW
+    }
+
+    matrix_row_t row = 0;
+    for (uint8_t col = 0; col < MATRIX_COLS; col++)
+    {
+        row |= (matrix_row_t)((low[s_col_port[col]] >> s_col_pad[col]) & 1u) << col;
+    }
+    return row;
+}
+
+// --- 깊은 유휴: 다이오드 방향(COL -> ROW)대로 컬럼을 HIGH로 구동하고 행은 풀다운 입력으로 전환.
+// 아무 키나 눌리면 해당 행이 HIGH가 되어 EXTI 상승 에지로 WFI에서 깨어남 ---
+
+static void row_wake_callback(void* arg)
+{
+    (void)arg;
+    s_wake_event = true;
+}
+
+static void arm_wake(void)
+{
+    // 행이 HIGH 출력인 상태에서 컬럼을 먼저 HIGH로 구동 (눌린 키가 있어도 전류 없음)
+    for (uint8_t col = 0; col < MATRIX_COLS; col++)
+    {
+        setPinOutput(kColPins[col]);
+        writePinHigh(kColPins[col]);
+    }
+    s_wake_event = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+    {
+        setPinInputLow(kRowPins[row]);
+        palEnableLineEvent(kRowPins[row], PAL_EVENT_MODE_RISING_EDGE);
+        palSetLineCallback(kRowPins[row], row_wake_callback, NULL);
+    }
+    s_wake_armed = true;
+}
+
+static void disarm_wake(void)
+{
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+    {
+        palDisableLineEvent(kRowPins[row]);
+        setPinOutput(kRowPins[row]);
+        writePinHigh(kRowPins[row]);
+    }
+    for (uint8_t col = 0; col < MATRIX_COLS; col++)
+    {
+        setPinInputHigh(kColPins[col]);
+    }
+    wait_cols_high();
+    s_wake_armed = false;
+}
+
+static inline bool any_row_high(void)
+{
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+    {
+        if (readPin(kRowPins[row])) return true;
+    }
+    return false;
+}
+
+// 다음 인터럽트(EXTI, USB SOF, 시스템 틱)까지 대기. 누름이 감지되면 true
+static bool sleep_until_press(void)
+{
+    // 확인과 WFI 사이에 들어온 에지를 놓치지 않도록 인터럽트를 막은 채로 WFI (대기 중인 인터럽트가 있으면 바로 깨어남)
+    chSysLock();
+    if (!s_wake_event && !any_row_high()) __WFI();
+    chSysUnlock();
+    return s_wake_event || any_row_high();
+}
+
+void matrix_init_custom(void)
+{
+    s_port_count = 0;
+    for (uint8_t col = 0; col < MATRIX_COLS; col++)
+    {
+        const uint8_t p = port_index(PAL_PORT(kColPins[col]));
+        s_col_port[col] = p;
+        s_col_pad[col] = (uint8_t)PAL_PAD(kColPins[col]);
+        s_port_masks[p] |= (ioportmask_t)1u << s_col_pad[col];
+        setPinInputHigh(kColPins[col]);
+    }
+
+    // 행은 푸시풀 출력으로 두고 비선택 시 HIGH (다이오드가 역방향이라 다른 행에 영향 없음).
+    // 행마다 입력/출력 모드를 바꾸지 않아도 되고, 해제 시 컬럼 복귀도 빨라짐
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+    {
+        setPinOutput(kRowPins[row]);
+        writePinHigh(kRowPins[row]);
+    }
+}
+
+bool matrix_scan_custom(matrix_row_t current_matrix[])
+{
+    const uint8_t idle_level = my_idle_level();
+    switch (idle_level)
+    {
+        case MY_IDLE_LIGHT:
+        {
+            // 감속 간격은 LIGHT에서만 필요하므로 ACTIVE 스캔은 타이머를 읽지 않음
+            // (ACTIVE에서 넘어온 첫 LIGHT 스캔은 오래된 값과 비교되어 바로 스캔함)
+            const uint16_t now = timer_read();
+            if ((uint16_t)(now - s_last_scan_ms) < MY_IDLE_LIGHT_SCAN_MS) return false;
+            s_last_scan_ms = now;
+            break;
+        }
+        case MY_IDLE_DEEP:
+            if (!s_wake_armed) arm_wake();
+            if (!sleep_until_press()) return false;
+            // 깨어난 즉시 같은 호출에서 전체 스캔 (첫 누름 지연 최소화)
+            disarm_wake();
+            my_idle_wake();
+            break;
+        default:
+            // 누름 없이 깬 뒤 다시 ACTIVE가 된 경우 등 무장 상태가 남아 있으면 해제
+            if (s_wake_armed) disarm_wake();
+            break;
+    }
+    MY_PERF_BEGIN(perf_start);
+    // 감속/대기 단계의 스캔 간격은 의도된 것이므로 오버런으로 세지 않음
+    MY_PERF_SCAN_TICK(perf_start, idle_level != MY_IDLE_ACTIVE);
+
+    bool changed = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+    {
+        writePinLow(kRowPins[row]);
+        waitInputPinDelay();
+        const matrix_row_t cols = read_cols();
+        writePinHigh(kRowPins[row]);
+
+        if (cols != 0) wait_cols_high();
+
+        if (current_matrix[row] != cols)
+        {
+            if (cols & ~current_matrix[row]) MY_PERF_PRESS_SEEN(row, cols & ~current_matrix[row], perf_start);
+            current_matrix[row] = cols;
+            changed = true;
+        }
+    }
+
+    MY_PERF_END(MY_PERF_SCAN, perf_start);
+    return changed;
+}
@@ -0,0 +1,388 @@
+// myfi: TIM14 기반 핫패스 타이밍 계측 (MYFI_PERF_ENABLE일 때만 빌드)
+#include "my_perf.h"
+#include "my_keycode.h"
+
+#ifdef MYFI_PERF_ENABLE
+
+// 슬롯별 누적값. 구간은 16비트 us 카운터로 재므로 65ms를 넘는 구간은 잘려서 기록됨
+typedef struct {
+    uint32_t count;
+    uint64_t sum_us;
+    uint16_t min_us;
+    uint16_t max_us;
+} my_perf_stat_t;
+
+uint32_t g_my_perf_counters[MY_PERF_COUNTER_COUNT];
+
+static my_perf_stat_t s_stats[MY_PERF_SLOT_COUNT];
+// 회귀 기준값 (초기화해도 유지, 0 = 미캡처)
+static uint32_t s_baseline[MY_PERF_METRIC_COUNT];
+static uint32_t s_overruns;
+static uint16_t s_scan_rate;      // 직전 1초 동안의 스캔 수
+static uint16_t s_scan_count;     // 현재 1초 창의 스캔 수
+static uint32_t s_rate_window_start;
+static uint16_t s_last_scan_us;
+static uint16_t s_last_scan_ms;
+static bool s_scan_started;
+
+// 누름 -> 보고서 지연
+enum my_perf_press_state {
+    PRESS_FREE = 0,
+    PRESS_SEEN,   // 스캔에서 봄, 아직 process_record 전
+    PRESS_EXPECT, // 보고서에 key(0이면 mods)가 나타나길 기다림
+};
+
+typedef struct {
+    uint8_t  state;
+    uint8_t  row;
+    uint8_t  col;
+    uint8_t  mods;
+    uint8_t  key;
+    uint16_t us;
+    uint16_t ms;
+} my_perf_press_t;
+
+static uint16_t s_latency_hist[MY_PERF_LATENCY_BUCKETS];
+static uint32_t s_latency_samples;
+static uint16_t s_latency_max_us;
+static my_perf_press_t s_presses[MY_PERF_PRESS_SLOTS];
+static uint8_t s_presses_open; // FREE가 아닌 슬롯 수 (0이면 보고서 경로에서 바로 반환)
+
+void my_perf_reset(void)
+{
+    for (uint8_t i = 0; i < MY_PERF_SLOT_COUNT; i++)
+    {
+        s_stats[i] = (my_perf_stat_t){ .count = 0, .sum_us = 0, .min_us = UINT16_MAX, .max_us = 0 };
+    }
+    for (uint8_t i = 0; i < MY_PERF_COUNTER_COUNT; i++)
+    {
+        g_my_perf_counters[i] = 0;
+    }
+    for (uint8_t i = 0; i < MY_PERF_LATENCY_BUCKETS; i++)
+    {
+        s_latency_hist[i] = 0;
+    }
+    s_latency_samples = 0;
+    s_latency_max_us = 0;
+    for (uint8_t i = 0; i < MY_PERF_PRESS_SLOTS; i++)
+    {
+        s_presses[i].state = PRESS_FREE;
+    }
+    s_presses_open = 0;
+    s_overruns = 0;
+    s_scan_rate = 0;
+    s_scan_count = 0;
+    s_rate_window_start = timer_read32();
+    s_scan_started = false;
+}
+
+void my_perf_init(void)
+{
+    // TIM14: 1MHz free-running 16비트 카운터 (인터럽트 없음)
+    rccEnableTIM14(true);
+    STM32_TIM14->CR1 = 0;
+    STM32_TIM14->PSC = (STM32_TIMCLK1 / 1000000u) - 1u;
+    STM32_TIM14->ARR = 0xFFFFu;
+    STM32_TIM14->EGR = STM32_TIM_EGR_UG;
+    STM32_TIM14->CR1 = STM32_TIM_CR1_CEN;
+    my_perf_reset();
+}
+
+void my_perf_record(uint8_t slot, uint16_t start)
+{
+    const uint16_t dt = (uint16_t)(my_perf_now() - start);
+    my_perf_stat_t* s = &s_stats[slot];
+    if (s->count == UINT32_MAX) return;
+    s->count++;
+    s->sum_us += dt;
+    if (dt < s->min_us) s->min_us = dt;
+    if (dt > s->max_us) s->max_us = dt;
+}
+
+void my_perf_scan_tick(uint16_t start, bool throttled)
+{
+    const uint16_t now_ms = timer_read();
+    if (s_scan_started && !throttled)
+    {
+        // us 카운터는 65ms마다 돌기 때문에 긴 정지는 ms 타이머로 판정
+        if ((uint16_t)(now_ms - s_last_scan_ms) > 60u || (uint16_t)(start - s_last_scan_us) > MY_PERF_OVERRUN_US)
+        {
+            s_overruns++;
+        }
+    }
+    s_scan_started = true;
+    s_last_scan_us = start;
+    s_last_scan_ms = now_ms;
+
+    if (s_scan_count != UINT16_MAX) s_scan_count++;
+    if (timer_elapsed32(s_rate_window_start) >= 1000u)
+    {
+        s_scan_rate = s_scan_count;
+        s_scan_count = 0;
+        s_rate_window_start = timer_read32();
+    }
+}
+
+static void press_free(my_perf_press_t* p)
+{
+    p->state = PRESS_FREE;
+    s_presses_open--;
+}
+
+// us 카운터는 65ms마다 돌기 때문에 오래된 누름은 ms 타이머로 걸러냄
+static void press_expire(void)
+{
+    for (uint8_t i = 0; i < MY_PERF_PRESS_SLOTS && s_presses_open != 0; i++)
+    {
+        my_perf_press_t* p = &s_presses[i];
+        if (p->state != PRESS_FREE && timer_elapsed(p->ms) > MY_PERF_LATENCY_EXPIRE_MS) press_free(p);
+    }
+}
+
+static my_perf_press_t* press_find(uint8_t row, uint8_t col)
+{
+    for (uint8_t i = 0; i < MY_PERF_PRESS_SLOTS; i++)
+    {
+        my_perf_press_t* p = &s_presses[i];
+        if (p->state != PRESS_FREE && p->row == row && p->col == col) return p;
+    }
+    return NULL;
+}
+
+static my_perf_press_t* press_alloc(void)
+{
+    for (uint8_t i = 0; i < MY_PERF_PRESS_SLOTS; i++)
+    {
+        if (s_presses[i].state == PRESS_FREE) return &s_presses[i];
+    }
+    return NULL;
+}
+
+void my_perf_press_seen(uint8_t row, matrix_row_t cols, uint16_t at)
+{
+    press_expire();
+    const uint16_t now_ms = timer_read();
+    while (cols != 0)
+    {
+        const uint8_t col = (uint8_t)__builtin_ctz(cols);
+        cols &= cols - 1u;
+        // 같은 키가 아직 열려 있으면(채터) 가장 이른 누름을 유지
+        if (press_find(row, col) != NULL) continue;
+
+        my_perf_press_t* p = press_alloc();
+        if (p == NULL) return;
+        *p = (my_perf_press_t){ .state = PRESS_SEEN, .row = row, .col = col, .us = at, .ms = now_ms };
+        s_presses_open++;
+    }
+}
+
+void my_perf_press_resolve(keypos_t key, uint16_t keycode)
+{
+    if (s_presses_open == 0) return;
+    my_perf_press_t* p = press_find(key.row, key.col);
+    if (p == NULL || p->state != PRESS_SEEN) return;
+
+    if (my_keycode_expected_report(keycode, &p->mods, &p->key))
+    {
+        p->state = PRESS_EXPECT;
+    }
+    else
+    {
+        // 레이어 키, 탭-홀드 키 등은 누름만으로 보낼 보고서가 정해지지 않음
+        press_free(p);
+    }
+}
+
+static void latency_record(uint16_t dt)
+{
+    uint16_t bucket = dt / MY_PERF_LATENCY_BUCKET_US;
+    if (bucket >= MY_PERF_LATENCY_BUCKETS) bucket = MY_PERF_LATENCY_BUCKETS - 1u;
+    if (s_latency_hist[bucket] != UINT16_MAX) s_latency_hist[bucket]++;
+    if (s_latency_samples != UINT32_MAX) s_latency_samples++;
+    if (dt > s_latency_max_us) s_latency_max_us = dt;
+}
+
+// has_key(report, key)가 참인 누름을 닫음. 모디파이어만 기대하는 누름은 mods 비트로 판정
+static void report_sent(uint8_t mods, bool (*has_key)(const void*, uint8_t), const void* report)
+{
+    if (s_presses_open == 0) return;
+    press_expire();
+    const uint16_t now = my_perf_now();
+    for (uint8_t i = 0; i < MY_PERF_PRESS_SLOTS && s_presses_open != 0; i++)
+    {
+        my_perf_press_t* p = &s_presses[i];
+        if (p->state != PRESS_EXPECT) continue;
+        const bool present = p->key ? has_key(report, p->key) : (mods & p->mods) == p->mods;
+        if (!present) continue;
+        latency_record((uint16_t)(now - p->us));
+        press_free(p);
+    }
+}
+
+static bool keyboard_has_key(const void* report, uint8_t key)
+{
+    const report_keyboard_t* r = report;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++)
+    {
+        if (r->keys[i] == key) return true;
+    }
+    return false;
+}
+
+static bool nkro_has_key(const void* report, uint8_t key)
+{
+    const report_nkro_t* r = report;
+    return (key >> 3) < NKRO_REPORT_BITS && (r->bits[key >> 3] & (1u << (key & 7u)));
+}
+
+void my_perf_report_keyboard(const report_keyboard_t* report)
+{
+    report_sent(report->mods, keyboard_has_key, report);
+}
+
+void my_perf_report_nkro(const report_nkro_t* report)
+{
+    report_sent(report->mods, nkro_has_key, report);
+}
+
+// 누적 분포에서 백분위 버킷의 상한(us)을 구함
+static uint16_t latency_percentile_us(uint8_t percent)
+{
+    if (s_latency_samples == 0) return 0;
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < MY_PERF_LATENCY_BUCKETS; i++)
+    {
+        total += s_latency_hist[i];
+    }
+    const uint32_t target = (total * percent + 99u) / 100u;
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < MY_PERF_LATENCY_BUCKETS; i++)
+    {
+        seen += s_latency_hist[i];
+        if (seen >= target) return (uint16_t)((i + 1u) * MY_PERF_LATENCY_BUCKET_US);
+    }
+    return s_latency_max_us;
+}
+
+static uint16_t slot_avg_us(uint8_t slot)
+{
+    const my_perf_stat_t* s = &s_stats[slot];
+    return s->count ? (uint16_t)(s->sum_us / s->count) : 0u;
+}
+
+static uint32_t metric_value(uint8_t metric)
+{
+    if (metric < MY_PERF_SLOT_COUNT) return slot_avg_us(metric);
+    const uint32_t scans = s_stats[MY_PERF_SCAN].count;
+    if (scans == 0) return 0;
+    return (uint32_t)(((uint64_t)g_my_perf_counters[metric - MY_PERF_SLOT_COUNT] << 8) / scans);
+}
+
+static void capture_baseline(void)
+{
+    for (uint8_t i = 0; i < MY_PERF_METRIC_COUNT; i++)
+    {
+        s_baseline[i] = metric_value(i);
+    }
+}
+
+static uint8_t regression_flags(void)
+{
+    uint8_t flags = 0;
+    for (uint8_t i = 0; i < MY_PERF_METRIC_COUNT; i++)
+    {
+        // 기준이 0이면 0에서 늘어난 경우만 잡힘 (1 이상이면 배수 비교)
+        const uint32_t base = s_baseline[i] ? s_baseline[i] : 1u;
+        if (metric_value(i) > base * MY_PERF_REGRESSION_RATIO) flags |= (uint8_t)(1u << i);
+    }
+    return flags;
+}
+
+_Static_assert(MY_PERF_METRIC_COUNT <= 8, "regression flags are reported in one byte");
+
+static inline void put_u16(uint8_t* p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put_u32(uint8_t* p, uint32_t v)
+{
+    put_u16(p, (uint16_t)v);
+    put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+static inline uint32_t get_u32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+#ifdef VIA_ENABLE
+void my_perf_via_command(uint8_t* command_id, uint8_t* value_id_and_data, uint8_t length)
+{
+    const uint8_t value_id = value_id_and_data[0];
+    uint8_t* out = &value_id_and_data[1];
+
+    if (*command_id == id_custom_set_value)
+    {
+        if (value_id == 1)
+        {
+            capture_baseline();
+        }
+        else if (value_id == 2)
+        {
+            // 호스트에 저장해 둔 기준값을 재부팅 뒤 다시 써 넣음 (범위 밖 지표는 무시)
+            if (length >= 1 + 5 && out[0] < MY_PERF_METRIC_COUNT) s_baseline[out[0]] = get_u32(out + 1);
+        }
+        else
+        {
+            my_perf_reset();
+        }
+    }
+    else if (*command_id == id_custom_get_value)
+    {
+        if (value_id == 0 && length >= 1 + 6)
+        {
+            put_u16(out, s_scan_rate);
+            put_u32(out + 2, s_overruns);
+        }
+        else if (value_id >= 1 && value_id <= MY_PERF_SLOT_COUNT && length >= 1 + 10)
+        {
+            const my_perf_stat_t* s = &s_stats[value_id - 1];
+            put_u32(out, s->count);
+            put_u16(out + 4, s->count ? s->min_us : 0u);
+            put_u16(out + 6, slot_avg_us(value_id - 1));
+            put_u16(out + 8, s->max_us);
+        }
+        else if (value_id == 4 && length >= 1 + MY_PERF_COUNTER_COUNT * 4 + 1)
+        {
+            for (uint8_t i = 0; i < MY_PERF_COUNTER_COUNT; i++)
+            {
+                put_u32(out + i * 4, g_my_perf_counters[i]);
+            }
+            out[MY_PERF_COUNTER_COUNT * 4] = regression_flags();
+        }
+        else if (value_id == 5 && length >= 1 + 10)
+        {
+            put_u32(out, s_latency_samples);
+            put_u16(out + 4, latency_percentile_us(50));
+            put_u16(out + 6, latency_percentile_us(99));
+            put_u16(out + 8, s_latency_max_us);
+        }
+        else if (value_id == 6 && length >= 1 + 5 && out[0] < MY_PERF_METRIC_COUNT)
+        {
+            put_u32(out + 1, s_baseline[out[0]]);
+        }
+        else
+        {
+            *command_id = id_unhandled;
+        }
+    }
+    else if (*command_id != id_custom_save)
+    {
+        *command_id = id_unhandled;
+    }
+}
+#endif
+
+#endif
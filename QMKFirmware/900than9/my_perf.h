@@ -0,0 +1,101 @@
+#pragma once
+
+#include "quantum.h"
+
+// 핫패스 타이밍 계측 (rules.mk: MYFI_PERF_ENABLE = yes)
+// M0에는 DWT 사이클 카운터가 없어서 TIM14를 1MHz로 free-running 시켜 us 단위로 측정.
+// 비활성화 시 매크로는 모두 빈 문장이 되고 my_perf.c도 빌드에서 빠짐
+
+enum my_perf_slot {
+    MY_PERF_SCAN = 0,        // matrix_scan_custom
+    MY_PERF_HOUSEKEEPING,    // housekeeping_task_user
+    MY_PERF_PROCESS_RECORD,  // process_record_user
+    MY_PERF_SLOT_COUNT
+};
+
+// 핫패스 작업량 카운터 (스캔 수로 나누면 스캔당 작업량)
+enum my_perf_counter {
+    MY_PERF_CNT_PIN_WRITE = 0, // LED 핀/PWM 듀티 레지스터 쓰기
+    MY_PERF_CNT_EFFECT_EVAL,   // my_effect_task가 출력을 다시 계산한 횟수
+    MY_PERF_CNT_MACRO_REPORT,  // 단축키 시퀀스 보고서 전송
+    MY_PERF_COUNTER_COUNT
+};
+
+// 회귀 판정 지표: 슬롯별 평균 us 3개 + 카운터별 스캔당 횟수(x256) 3개.
+// 기준값을 캡처한 뒤 지표가 기준의 이 배수를 넘으면 해당 비트를 세움
+#define MY_PERF_METRIC_COUNT      (MY_PERF_SLOT_COUNT + MY_PERF_COUNTER_COUNT)
+#define MY_PERF_REGRESSION_RATIO  2u
+
+// 스캔 시작 간격이 이 값을 넘으면 루프 오버런으로 집계 (USB 폴링 주기 1ms 기준)
+#define MY_PERF_OVERRUN_US 1000u
+
+// 누름 -> 보고서 지연 히스토그램: 스캔에서 새 누름(raw, 디바운스 전)을 처음 본 시각부터
+// 그 누름의 키(모디파이어는 mod 비트)가 들어간 첫 보고서가 호스트 드라이버로 나갈 때까지.
+// 키별로 따로 재고, 누름만으로 보고서가 정해지지 않는 키(MO/LT/MT 등)는 process_record에서 버림.
+// 버킷 폭 250us, 마지막 버킷은 초과분
+#define MY_PERF_LATENCY_BUCKET_US 250u
+#define MY_PERF_LATENCY_BUCKETS   64u
+// 동시에 추적하는 누름 수 (넘치면 새 누름은 재지 않음)
+#define MY_PERF_PRESS_SLOTS       8u
+// 이 시간 안에 보고서가 없으면(디바운스에 걸린 채터 등) 누름 기록을 버림
+#define MY_PERF_LATENCY_EXPIRE_MS 50u
+
+// VIA 채널 40: 계측값 읽기/초기화
+// get value id 0: [scans/s u16][overruns u32]
+// get value id 1..3: 슬롯별 [count u32][min us u16][avg us u16][max us u16]
+// get value id 4: [카운터 u32 x MY_PERF_COUNTER_COUNT][회귀 비트 u8 (bit i = 지표 i)]
+// get value id 5: 누름->보고서 지연 [samples u32][p50 us u16][p99 us u16][max us u16]
+// get value id 6: [지표 u8] -> [지표 u8][기준값 u32]
+// set value id 0: 전체 초기화
+// set value id 1: 현재 지표를 회귀 기준값으로 캡처 (변경 전 펌웨어에서 캡처 후 비교)
+// set value id 2: [지표 u8][기준값 u32] 기준값 쓰기. 기준값은 RAM에만 있으므로
+//                 호스트가 id 6으로 읽어 보관했다가 새 펌웨어를 올린 뒤 다시 씀
+#define MYFI_VIA_CHANNEL_PERF 40
+
+#ifdef MYFI_PERF_ENABLE
+#include "hal.h"
+// STM32_TIM14 / STM32_TIM_* 정의. hal.h는 PWM/GPT 드라이버가 켜져 있을 때만 간접적으로 포함함
+#include "stm32_tim.h"
+#include "host.h"
+
+extern uint32_t g_my_perf_counters[MY_PERF_COUNTER_COUNT];
+
+void my_perf_init(void);
+void my_perf_record(uint8_t slot, uint16_t start);
+// 스캔마다 호출: 스캔율, 오버런 집계 (throttled = 유휴 단계에서 일부러 늦춘 스캔, 오버런 판정 제외)
+void my_perf_scan_tick(uint16_t start, bool throttled);
+// 스캔에서 새로 눌린 키(cols = 이번 스캔에 새로 켜진 열 비트)를 본 시각
+void my_perf_press_seen(uint8_t row, matrix_row_t cols, uint16_t at);
+// process_record_user에서 누름마다 호출: 이 누름이 보고서에 나타날 모양을 정함
+void my_perf_press_resolve(keypos_t key, uint16_t keycode);
+// 보고서 전송 직전에 호출 (my_boot.c의 호스트 드라이버 래퍼). 키가 들어간 누름만 닫음
+void my_perf_report_keyboard(const report_keyboard_t* report);
+void my_perf_report_nkro(const report_nkro_t* report);
+void my_perf_reset(void);
+#ifdef VIA_ENABLE
+void my_perf_via_command(uint8_t* command_id, uint8_t* value_id_and_data, uint8_t length);
+#endif
+
+static inline uint16_t my_perf_now(void)
+{
+    return (uint16_t)STM32_TIM14->CNT;
+}
+
+#define MY_PERF_BEGIN(var)                  const uint16_t var = my_perf_now()
+#define MY_PERF_END(slot, var)              my_perf_record((slot), (var))
+#define MY_PERF_SCAN_TICK(var, throttled)   my_perf_scan_tick((var), (throttled))
+#define MY_PERF_COUNT(counter)              (g_my_perf_counters[(counter)]++)
+#define MY_PERF_PRESS_SEEN(row, cols, var)  my_perf_press_seen((row), (cols), (var))
+#define MY_PERF_PRESS_RESOLVE(key, keycode) my_perf_press_resolve((key), (keycode))
+#define MY_PERF_REPORT_KEYBOARD(report)     my_perf_report_keyboard(report)
+#define MY_PERF_REPORT_NKRO(report)         my_perf_report_nkro(report)
+#else
+#define MY_PERF_BEGIN(var)                  do {} while (0)
+#define MY_PERF_END(slot, var)              do {} while (0)
+#define MY_PERF_SCAN_TICK(var, throttled)   do {} while (0)
+#define MY_PERF_COUNT(counter)              do {} while (0)
+#define MY_PERF_PRESS_SEEN(row, cols, var)  do {} while (0)
+#define MY_PERF_PRESS_RESOLVE(key, keycode) do {} while (0)
+#define MY_PERF_REPORT_KEYBOARD(report)     do {} while (0)
+#define MY_PERF_REPORT_NKRO(report)         do {} while (0)
+#endif
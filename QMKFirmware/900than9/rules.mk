@@ -1,6 +1,32 @@
 VIA_ENABLE = yes
 OS_DETECTION_ENABLE = yes
 # BACKLIGHT_ENABLE = yes
+
+# 키별 eager-press / deferred-release 디바운스 (my_debounce.c)
+DEBOUNCE_TYPE = custom
+
+# 포트 단위로 컬럼을 읽는 매트릭스 스캔 (my_matrix.c)
+CUSTOM_MATRIX = lite
+
+# LED 출력 드라이버: pwm = TIM3 하드웨어 PWM, soft = GPIO 소프트웨어 PWM (폴백)
+MYFI_LED_DRIVER ?= pwm
+ifeq ($(strip $(MYFI_LED_DRIVER)), pwm)
+    OPT_DEFS += -DMYFI_LED_DRIVER_PWM
+endif
+
+# 핫패스 타이밍 계측 (my_perf.c, VIA 채널 40). 끄면 계측 코드가 모두 빠짐
+MYFI_PERF_ENABLE ?= no
+ifeq ($(strip $(MYFI_PERF_ENABLE)), yes)
+    OPT_DEFS += -DMYFI_PERF_ENABLE
+    SRC += my_perf.c
+endif
+
 SRC += my_config.c
 SRC += my_keycode.c
 SRC += my_effect.c
+SRC += my_led.c
+SRC += my_debounce.c
+SRC += my_matrix.c
+SRC += my_idle.c
+SRC += my_keymap.c
+SRC += my_boot.c
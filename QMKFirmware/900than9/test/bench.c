@@ -0,0 +1,361 @@
+// 핫패스 벤치마크: 시나리오별로 메인 루프를 돌려 구간당 호스트 실행 시간(ns/call)과
+// 메인 루프 한 바퀴당 스텁 호출 횟수를 출력. 펌웨어 변경 전후를 비교하는 용도
+//   bench                  결과 출력
+//   bench --save FILE      결과를 기준값으로 저장
+//   bench --check FILE     기준값과 비교. 시간은 기준의 --ratio 배(기본 MY_PERF_REGRESSION_RATIO)와
+//                          BENCH_NOISE_FLOOR_NS를 모두 넘을 때, 호출 횟수는 1%를 넘게 늘 때
+//                          회귀로 보고 종료 코드 1
+#include "sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "my_config.h"
+#include "my_effect.h"
+#include "my_keycode.h"
+#include "my_perf.h"
+
+#ifdef MYFI_LED_DRIVER_PWM
+#define BENCH_CONFIG "pwm"
+#else
+#define BENCH_CONFIG "soft"
+#endif
+
+// 시나리오 하나를 이 시간(시뮬레이션 ms)만큼 돌리는 것을 BENCH_REPEAT번 반복. 시간은 최솟값을 씀
+#define BENCH_WINDOW_MS 1000u
+#define BENCH_REPEAT    9u
+// 호스트 시간은 캐시/스케줄링 잡음이 커서 배수와 함께 이 차이도 넘어야 회귀로 봄.
+// 정밀한 신호는 결정적인 호출 횟수 쪽
+#define BENCH_NOISE_FLOOR_NS 500.0
+// 호출 횟수는 시뮬레이션이 결정적이라 흔들리지 않음. 부동소수 출력 오차만 허용
+#define BENCH_COUNT_TOLERANCE 1.01
+
+enum bench_metric {
+    M_SCAN_NS = 0,
+    M_HOUSEKEEPING_NS,
+    M_RECORD_NS,
+    M_PIN_WRITES,
+    M_PIN_READS,
+    M_PORT_READS,
+    M_PWM_WRITES,
+    M_TIMER_CALLS,
+    M_REPORTS,
+    M_COUNT
+};
+
+// clang-format off
+static const char* const kMetricNames[M_COUNT] = {
+    "scan_ns", "hk_ns", "rec_ns", "pin_w", "pin_r", "port_r", "pwm_w", "timer", "reports",
+};
+// clang-format on
+
+#define M_FIRST_COUNT M_PIN_WRITES
+
+typedef struct {
+    const char* name;
+    void (*setup)(void);
+    void (*step)(uint32_t ms); // 창 안에서 1ms마다 호출 (NULL = 입력 없음)
+} bench_scenario_t;
+
+static double s_clock_overhead_ns;
+
+static uint64_t host_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// 빈 구간을 잰 값 = 측정 자체의 비용. ns/call에서 뺌
+static void calibrate_clock(void)
+{
+    const uint32_t n = 200000u;
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const uint64_t t0 = host_ns();
+        sum += host_ns() - t0;
+    }
+    s_clock_overhead_ns = (double)sum / n;
+}
+
+static void via_set(uint8_t channel, uint8_t value_id, uint8_t value)
+{
+    uint8_t data[32] = { id_custom_set_value, channel, value_id, value };
+    sim_via(data, sizeof(data));
+}
+
+static void set_all_leds(uint8_t flags)
+{
+    for (uint8_t i = 0; i < MY_LED_COUNT; i++)
+    {
+        via_set(MYFI_VIA_CHANNEL_LED_BASE + i, MYFI_VIA_LED_FLAGS, flags);
+    }
+}
+
+// --- 시나리오 ---
+
+static void setup_idle(void)
+{
+    set_all_leds(LED_MODE_NONE);
+}
+
+static void setup_breathing(void)
+{
+    set_all_leds(LED_MODE_BREATHING);
+}
+
+static void setup_indicator(void)
+{
+    set_all_leds(LED_MODE_NONE);
+    via_set(MYFI_VIA_CHANNEL_INDICATOR_BASE, 0, IND_CAPS);
+    sim_set_host_leds(0x02);
+}
+
+static void setup_typing(void)
+{
+    set_all_leds(LED_MODE_TYPING_HOLD | LED_MODE_BREATHING);
+}
+
+// 30ms마다 문자 키 4개를 돌아가며 12ms씩 누름
+static void step_typing(uint32_t ms)
+{
+    static const uint8_t kKeys[][2] = { { 2, 2 }, { 3, 3 }, { 2, 5 }, { 3, 6 } };
+    const uint8_t* key = kKeys[(ms / 30u) % ARRAY_SIZE(kKeys)];
+    if (ms % 30u == 0) sim_key(key[0], key[1], true);
+    if (ms % 30u == 12u) sim_key(key[0], key[1], false);
+}
+
+static void setup_shortcut(void)
+{
+    set_all_leds(LED_MODE_NONE);
+    sim_set_detected_os(OS_WINDOWS);
+    uint8_t data[32] = { id_dynamic_keymap_set_keycode, 0, 2, 2, (uint8_t)(VC_FLDA >> 8), (uint8_t)VC_FLDA };
+    sim_via(data, sizeof(data));
+}
+
+// 50ms마다 보고서 4개짜리 단축키를 탭
+static void step_shortcut(uint32_t ms)
+{
+    if (ms % 50u == 0) sim_key(2, 2, true);
+    if (ms % 50u == 10u) sim_key(2, 2, false);
+}
+
+static const bench_scenario_t kScenarios[] = {
+    { "idle",      setup_idle,      NULL },
+    { "breathing", setup_breathing, NULL },
+    { "indicator", setup_indicator, NULL },
+    { "typing",    setup_typing,    step_typing },
+    { "shortcut",  setup_shortcut,  step_shortcut },
+};
+
+#define SCENARIO_COUNT ARRAY_SIZE(kScenarios)
+
+static double s_results[SCENARIO_COUNT][M_COUNT];
+
+static double ns_per_call(const sim_section_t* s)
+{
+    if (s->calls == 0) return 0;
+    const double ns = (double)s->ns / (double)s->calls - s_clock_overhead_ns;
+    return ns > 0 ? ns : 0;
+}
+
+static void run_scenario(size_t index)
+{
+    const bench_scenario_t* sc = &kScenarios[index];
+    double* out = s_results[index];
+
+    sim_eeprom_erase();
+    sim_boot();
+    // 미뤄 둔 LED 초기화가 끝나고 유휴 단계가 자리 잡도록 대기
+    sim_run_ms(2000);
+    sc->setup();
+    sim_run_ms(100);
+
+    for (uint8_t m = 0; m < M_FIRST_COUNT; m++)
+    {
+        out[m] = -1;
+    }
+    for (uint32_t rep = 0; rep < BENCH_REPEAT; rep++)
+    {
+        // 보고서 기록 버퍼가 늘어나는(realloc) 비용이 전송 구간에 섞이지 않게 비움
+        sim_reports_clear();
+        memset(g_sim_sections, 0, sizeof(g_sim_sections));
+        const sim_stats_t before = g_sim_stats;
+        uint64_t loops = 0;
+
+        g_sim_profile = true;
+        for (uint32_t ms = 0; ms < BENCH_WINDOW_MS; ms++)
+        {
+            if (sc->step) sc->step(ms);
+            const uint64_t target = g_sim_us + 1000u;
+            while (g_sim_us < target)
+            {
+                sim_task();
+                loops++;
+            }
+        }
+        g_sim_profile = false;
+
+        const double times[] = {
+            ns_per_call(&g_sim_sections[SIM_SECTION_SCAN]),
+            ns_per_call(&g_sim_sections[SIM_SECTION_HOUSEKEEPING]),
+            ns_per_call(&g_sim_sections[SIM_SECTION_PROCESS_RECORD]),
+        };
+        for (uint8_t m = 0; m < M_FIRST_COUNT; m++)
+        {
+            if (out[m] < 0 || times[m] < out[m]) out[m] = times[m];
+        }
+
+        const double n = (double)loops;
+        out[M_PIN_WRITES] = (double)(g_sim_stats.pin_writes - before.pin_writes) / n;
+        out[M_PIN_READS] = (double)(g_sim_stats.pin_reads - before.pin_reads) / n;
+        out[M_PORT_READS] = (double)(g_sim_stats.port_reads - before.port_reads) / n;
+        out[M_PWM_WRITES] = (double)(g_sim_stats.pwm_writes - before.pwm_writes) / n;
+        out[M_TIMER_CALLS] = (double)(g_sim_stats.timer_reads - before.timer_reads + g_sim_stats.timer_elapsed -
+                                      before.timer_elapsed) / n;
+        out[M_REPORTS] = (double)(g_sim_stats.reports - before.reports) / n;
+    }
+}
+
+static void print_results(void)
+{
+    printf("bench (%s): ns/call minus %.0f ns clock overhead, min of %u; counts per main loop\n", BENCH_CONFIG,
+           s_clock_overhead_ns, BENCH_REPEAT);
+    printf("%-10s", "scenario");
+    for (uint8_t m = 0; m < M_COUNT; m++)
+    {
+        printf(" %8s", kMetricNames[m]);
+    }
+    printf("\n");
+    for (size_t i = 0; i < SCENARIO_COUNT; i++)
+    {
+        printf("%-10s", kScenarios[i].name);
+        for (uint8_t m = 0; m < M_COUNT; m++)
+        {
+            printf(m < M_FIRST_COUNT ? " %8.1f" : " %8.4f", s_results[i][m]);
+        }
+        printf("\n");
+    }
+}
+
+static int save_results(const char* path)
+{
+    FILE* f = fopen(path, "w");
+    if (!f)
+    {
+        perror(path);
+        return 2;
+    }
+    fprintf(f, "# bench %s baseline: <scenario> <metric> <value>\n", BENCH_CONFIG);
+    for (size_t i = 0; i < SCENARIO_COUNT; i++)
+    {
+        for (uint8_t m = 0; m < M_COUNT; m++)
+        {
+            fprintf(f, "%s %s %.6f\n", kScenarios[i].name, kMetricNames[m], s_results[i][m]);
+        }
+    }
+    fclose(f);
+    printf("baseline saved to %s\n", path);
+    return 0;
+}
+
+static int find_scenario(const char* name)
+{
+    for (size_t i = 0; i < SCENARIO_COUNT; i++)
+    {
+        if (strcmp(kScenarios[i].name, name) == 0) return (int)i;
+    }
+    return -1;
+}
+
+static int find_metric(const char* name)
+{
+    for (uint8_t m = 0; m < M_COUNT; m++)
+    {
+        if (strcmp(kMetricNames[m], name) == 0) return m;
+    }
+    return -1;
+}
+
+// 기준 파일에 없는 지표(시나리오 추가 등)는 비교하지 않음
+static int check_results(const char* path, double ratio)
+{
+    FILE* f = fopen(path, "r");
+    if (!f)
+    {
+        perror(path);
+        return 2;
+    }
+    char line[128];
+    int regressions = 0;
+    int compared = 0;
+    while (fgets(line, sizeof(line), f))
+    {
+        char scenario[32];
+        char metric[32];
+        double base;
+        if (line[0] == '#' || sscanf(line, "%31s %31s %lf", scenario, metric, &base) != 3) continue;
+        const int si = find_scenario(scenario);
+        const int mi = find_metric(metric);
+        if (si < 0 || mi < 0) continue;
+
+        compared++;
+        const double cur = s_results[si][mi];
+        double limit = base * BENCH_COUNT_TOLERANCE + 1e-6;
+        if (mi < M_FIRST_COUNT)
+        {
+            limit = base * ratio;
+            if (limit < base + BENCH_NOISE_FLOOR_NS) limit = base + BENCH_NOISE_FLOOR_NS;
+        }
+        if (cur > limit)
+        {
+            regressions++;
+            printf("REGRESSION %s %s: %.4f, baseline %.4f (limit %.4f)\n", scenario, metric, cur, base, limit);
+        }
+    }
+    fclose(f);
+    printf("%d metrics compared with %s, %d regressed\n", compared, path, regressions);
+    return regressions ? 1 : 0;
+}
+
+int main(int argc, char** argv)
+{
+    const char* save_path = NULL;
+    const char* check_path = NULL;
+    double ratio = MY_PERF_REGRESSION_RATIO;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--save") == 0 && i + 1 < argc)
+        {
+            save_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--check") == 0 && i + 1 < argc)
+        {
+            check_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--ratio") == 0 && i + 1 < argc)
+        {
+            ratio = atof(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--save FILE] [--check FILE [--ratio R]]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    calibrate_clock();
+    for (size_t i = 0; i < SCENARIO_COUNT; i++)
+    {
+        run_scenario(i);
+    }
+    print_results();
+
+    int status = 0;
+    if (save_path) status = save_results(save_path);
+    if (check_path && status == 0) status = check_results(check_path, ratio);
+    return status;
+}
@@ -0,0 +1,214 @@
+// 키 입력 트레이스 재생: 트레이스의 물리 누름을 시뮬레이션에 넣고 1ms USB 폴링으로 호스트가
+// 그 키(모디파이어는 mod 비트, 단축키는 첫 보고서의 키)가 들어간 보고서를 처음 가져간 시각까지의
+// 지연을 모아 p50/p99/max를 출력. 다중 보고서 단축키와 재생 중 보류된 키도 그대로 지나감
+//   replay FILE
+//
+// 트레이스 형식 (한 줄에 하나, '#' 뒤는 주석)
+//   os win|mac              감지된 호스트 OS
+//   map LAYER ROW COL HEX   동적 키맵에 키코드 쓰기 (예: map 0 0 15 0x7E0A)
+//   loop US                 메인 루프 한 바퀴 시간 (기본 100)
+//   TIME_US ROW COL d|u     재생 시작부터의 시각에 물리 키 누름(d) / 뗌(u)
+// 설정 줄은 읽힌 순서대로 그 시각에 적용됨
+#include "sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "my_keycode.h"
+
+// 마지막 이벤트 뒤로 남은 보고서가 나가도록 더 도는 시간
+#define REPLAY_TAIL_MS 200u
+
+typedef struct {
+    uint64_t us;   // 물리 누름 시각 (시뮬레이션 시계)
+    uint8_t  row;
+    uint8_t  col;
+} replay_press_t;
+
+static replay_press_t* s_presses;
+static size_t s_press_count;
+static size_t s_press_cap;
+
+static void add_press(uint8_t row, uint8_t col)
+{
+    if (s_press_count == s_press_cap)
+    {
+        s_press_cap = s_press_cap ? s_press_cap * 2u : 256u;
+        s_presses = realloc(s_presses, s_press_cap * sizeof(*s_presses));
+        if (s_presses == NULL) abort();
+    }
+    s_presses[s_press_count++] = (replay_press_t){ .us = g_sim_us, .row = row, .col = col };
+}
+
+static void run_until(uint64_t us)
+{
+    while (g_sim_us < us) sim_task();
+}
+
+static int replay_file(const char* path)
+{
+    FILE* f = fopen(path, "r");
+    if (!f)
+    {
+        perror(path);
+        return 2;
+    }
+
+    const uint64_t start = g_sim_us;
+    char line[128];
+    unsigned line_no = 0;
+    while (fgets(line, sizeof(line), f))
+    {
+        line_no++;
+        char* hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+
+        char word[16];
+        unsigned long long t;
+        unsigned a, b, c, kc;
+        char dir;
+        if (sscanf(line, " %15s", word) != 1) continue;
+
+        if (strcmp(word, "os") == 0 && sscanf(line, " os %15s", word) == 1)
+        {
+            sim_set_detected_os(strcmp(word, "win") == 0 ? OS_WINDOWS : OS_MACOS);
+        }
+        else if (sscanf(line, " map %u %u %u %x", &a, &b, &c, &kc) == 4)
+        {
+            uint8_t data[32] = { id_dynamic_keymap_set_keycode, (uint8_t)a, (uint8_t)b, (uint8_t)c, (uint8_t)(kc >> 8),
+                                 (uint8_t)kc };
+            sim_via(data, sizeof(data));
+        }
+        else if (sscanf(line, " loop %u", &a) == 1)
+        {
+            g_sim_loop_us = a;
+        }
+        else if (sscanf(line, " %llu %u %u %c", &t, &a, &b, &dir) == 4 && a < MATRIX_ROWS && b < MATRIX_COLS &&
+                 (dir == 'd' || dir == 'u'))
+        {
+            run_until(start + t);
+            sim_key((uint8_t)a, (uint8_t)b, dir == 'd');
+            if (dir == 'd') add_press((uint8_t)a, (uint8_t)b);
+        }
+        else
+        {
+            fprintf(stderr, "%s:%u: cannot parse: %s\n", path, line_no, line);
+            fclose(f);
+            return 2;
+        }
+    }
+    fclose(f);
+    run_until(g_sim_us + REPLAY_TAIL_MS * 1000u);
+    return 0;
+}
+
+// 물리 누름 뒤 process_record가 처음 받은 같은 키의 누름 (보류 후 재진입은 건너뜀)
+static const sim_press_t* resolved_press(const replay_press_t* p)
+{
+    for (size_t i = 0; i < sim_press_count(); i++)
+    {
+        const sim_press_t* r = sim_press(i);
+        if (r->us >= p->us && r->key.row == p->row && r->key.col == p->col) return r;
+    }
+    return NULL;
+}
+
+// 누름 뒤 처음으로 기대한 키/mods가 들어간 채 호스트에 전달된 보고서
+static const sim_report_t* first_report(uint64_t after_us, uint8_t mods, uint8_t key)
+{
+    for (size_t i = 0; i < sim_report_count(); i++)
+    {
+        const sim_report_t* r = sim_report(i);
+        if (r->sent_us < after_us || r->delivered_us == 0) continue;
+        if (key ? sim_report_has_key(r, key) : (r->mods & mods) == mods) return r;
+    }
+    return NULL;
+}
+
+static int compare_u32(const void* a, const void* b)
+{
+    const uint32_t x = *(const uint32_t*)a;
+    const uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// 최근접 순위 백분위
+static uint32_t percentile(const uint32_t* sorted, size_t count, uint8_t percent)
+{
+    size_t rank = (count * percent + 99u) / 100u;
+    if (rank == 0) rank = 1;
+    return sorted[rank - 1u];
+}
+
+static void print_stats(const char* name, uint32_t* samples, size_t count)
+{
+    if (count == 0)
+    {
+        printf("  %-9s %4zu presses\n", name, count);
+        return;
+    }
+    qsort(samples, count, sizeof(*samples), compare_u32);
+    printf("  %-9s %4zu presses  p50 %5u us  p99 %5u us  max %5u us\n", name, count,
+           percentile(samples, count, 50), percentile(samples, count, 99), samples[count - 1u]);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s TRACE\n", argv[0]);
+        return 2;
+    }
+
+    sim_eeprom_erase();
+    sim_boot();
+    // 미뤄 둔 LED 초기화와 부팅 보고서가 끝난 뒤부터 기록
+    sim_run_ms(2000);
+    sim_reports_clear();
+    sim_presses_clear();
+
+    const int status = replay_file(argv[1]);
+    if (status != 0) return status;
+
+    uint32_t* all = calloc(s_press_count + 1u, sizeof(uint32_t));
+    uint32_t* shortcuts = calloc(s_press_count + 1u, sizeof(uint32_t));
+    if (all == NULL || shortcuts == NULL) abort();
+    size_t all_count = 0;
+    size_t shortcut_count = 0;
+    size_t no_report = 0;
+    size_t lost = 0;
+
+    for (size_t i = 0; i < s_press_count; i++)
+    {
+        const replay_press_t* p = &s_presses[i];
+        const sim_press_t* r = resolved_press(p);
+        uint8_t mods;
+        uint8_t key;
+        if (r == NULL || !my_keycode_expected_report(r->keycode, &mods, &key))
+        {
+            // 디바운스에 걸린 누름, 레이어/탭-홀드 키, KC_NO
+            no_report++;
+            continue;
+        }
+        const sim_report_t* report = first_report(r->us, mods, key);
+        if (report == NULL)
+        {
+            lost++;
+            fprintf(stderr, "press at %llu us (%u, %u) keycode 0x%04x: no report\n", (unsigned long long)p->us, p->row,
+                    p->col, r->keycode);
+            continue;
+        }
+        const uint32_t dt = (uint32_t)(report->delivered_us - p->us);
+        all[all_count++] = dt;
+        if ((uint16_t)(r->keycode - QK_KB_0) < MY_KEYCODE_COUNT) shortcuts[shortcut_count++] = dt;
+    }
+
+    printf("%s: %zu presses, %zu without a report of their own (layer/tap-hold/no-op), loop %u us\n", argv[1],
+           s_press_count, no_report, g_sim_loop_us);
+    print_stats("all", all, all_count);
+    print_stats("shortcut", shortcuts, shortcut_count);
+    free(all);
+    free(shortcuts);
+    return lost ? 1 : 0;
+}
@@ -0,0 +1,969 @@
+// 900than9 호스트 시뮬레이션 구현 (sim.h)
+#include "sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "debounce.h"
+#include "dynamic_keymap.h"
+#include "keymap_introspection.h"
+#include "matrix.h"
+#include "raw_hid.h"
+#include "stm32_tim.h"
+#include "usb_main.h"
+
+uint64_t g_sim_us;
+uint32_t g_sim_loop_us = 100u;
+sim_stats_t g_sim_stats;
+bool g_sim_profile;
+sim_section_t g_sim_sections[SIM_SECTION_COUNT];
+uint8_t g_sim_raw_hid_response[32];
+
+stm32_tim_t g_sim_tim14;
+PWMDriver PWMD3;
+USBDriver USBD1;
+layer_state_t layer_state;
+
+static inline uint32_t now_ms(void)
+{
+    return (uint32_t)(g_sim_us / 1000u);
+}
+
+static uint64_t profile_begin(void)
+{
+    if (!g_sim_profile) return 0;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void profile_end(uint8_t section, uint64_t start)
+{
+    if (!g_sim_profile) return;
+    g_sim_sections[section].ns += profile_begin() - start;
+    g_sim_sections[section].calls++;
+}
+
+// --- 보고서 기록 / USB 폴링 ---
+
+static sim_report_t* s_reports;
+static size_t s_report_count;
+static size_t s_report_cap;
+static size_t s_report_next; // 다음 폴링에서 전달할 보고서
+
+static void usb_poll(void)
+{
+    if (s_report_next < s_report_count) s_reports[s_report_next++].delivered_us = g_sim_us;
+}
+
+void sim_advance_us(uint32_t us)
+{
+    const uint64_t target = g_sim_us + us;
+    for (;;)
+    {
+        const uint64_t boundary = (g_sim_us / 1000u + 1u) * 1000u;
+        if (boundary > target) break;
+        g_sim_us = boundary;
+        usb_poll();
+    }
+    g_sim_us = target;
+    g_sim_tim14.CNT = (uint16_t)g_sim_us;
+}
+
+static void record_report(uint8_t mods, const uint8_t* bits)
+{
+    if (s_report_count == s_report_cap)
+    {
+        s_report_cap = s_report_cap ? s_report_cap * 2u : 256u;
+        s_reports = realloc(s_reports, s_report_cap * sizeof(*s_reports));
+        if (s_reports == NULL) abort();
+    }
+    sim_report_t* r = &s_reports[s_report_count++];
+    r->sent_us = g_sim_us;
+    r->delivered_us = 0;
+    r->mods = mods;
+    memcpy(r->bits, bits, NKRO_REPORT_BITS);
+    g_sim_stats.reports++;
+}
+
+size_t sim_report_count(void)
+{
+    return s_report_count;
+}
+
+const sim_report_t* sim_report(size_t index)
+{
+    return (index < s_report_count) ? &s_reports[index] : NULL;
+}
+
+void sim_reports_clear(void)
+{
+    s_report_count = 0;
+    s_report_next = 0;
+}
+
+bool sim_report_has_key(const sim_report_t* report, uint8_t keycode)
+{
+    if (keycode >= NKRO_REPORT_BITS * 8u) return false;
+    return (report->bits[keycode >> 3] >> (keycode & 7u)) & 1u;
+}
+
+uint8_t sim_report_key_count(const sim_report_t* report)
+{
+    uint8_t count = 0;
+    for (uint16_t kc = 0; kc < NKRO_REPORT_BITS * 8u; kc++)
+    {
+        if (sim_report_has_key(report, (uint8_t)kc)) count++;
+    }
+    return count;
+}
+
+static uint8_t sim_keyboard_leds(void)
+{
+    return host_keyboard_led_state().raw;
+}
+
+static void sim_send_keyboard(report_keyboard_t* report)
+{
+    uint8_t bits[NKRO_REPORT_BITS] = { 0 };
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++)
+    {
+        const uint8_t kc = report->keys[i];
+        if (kc != 0 && kc < NKRO_REPORT_BITS * 8u) bits[kc >> 3] |= (uint8_t)(1u << (kc & 7u));
+    }
+    record_report(report->mods, bits);
+}
+
+static void sim_send_nkro(report_nkro_t* report)
+{
+    record_report(report->mods, report->bits);
+}
+
+static host_driver_t s_sim_driver = {
+    .keyboard_leds = sim_keyboard_leds,
+    .send_keyboard = sim_send_keyboard,
+    .send_nkro     = sim_send_nkro,
+};
+static host_driver_t* s_host_driver;
+
+host_driver_t* host_get_driver(void)
+{
+    return s_host_driver;
+}
+
+void host_set_driver(host_driver_t* driver)
+{
+    s_host_driver = driver;
+}
+
+// --- 타이머 ---
+
+uint16_t timer_read(void)
+{
+    g_sim_stats.timer_reads++;
+    return (uint16_t)now_ms();
+}
+
+uint32_t timer_read32(void)
+{
+    g_sim_stats.timer_reads++;
+    return now_ms();
+}
+
+uint16_t timer_elapsed(uint16_t last)
+{
+    g_sim_stats.timer_elapsed++;
+    return (uint16_t)((uint16_t)now_ms() - last);
+}
+
+uint32_t timer_elapsed32(uint32_t last)
+{
+    g_sim_stats.timer_elapsed++;
+    return now_ms() - last;
+}
+
+// --- 핀 ---
+
+enum sim_pin_mode {
+    SIM_PIN_UNUSED = 0,
+    SIM_PIN_OUTPUT,
+    SIM_PIN_PULLUP,
+    SIM_PIN_PULLDOWN,
+    SIM_PIN_ALTERNATE,
+};
+
+typedef struct {
+    uint8_t       mode;
+    bool          out;
+    bool          event;       // 상승 에지 이벤트 활성
+    bool          event_level; // 마지막으로 본 입력 레벨 (에지 검출용)
+    palcallback_t callback;
+    void*         arg;
+} sim_pin_t;
+
+static sim_pin_t s_pins[SIM_PORT_COUNT][16];
+static const pin_t kRowPins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t kColPins[MATRIX_COLS] = MATRIX_COL_PINS;
+static matrix_row_t s_phys[MATRIX_ROWS]; // 물리적으로 눌린 키
+
+#define SIM_PIN_HISTORY_MAX (1u << 18)
+static sim_pin_change_t s_history[SIM_PIN_HISTORY_MAX];
+static size_t s_history_count;
+
+static sim_pin_t* pin_at(pin_t line)
+{
+    return &s_pins[PAL_PORT(line) % SIM_PORT_COUNT][PAL_PAD(line) & 15u];
+}
+
+static int8_t row_of(pin_t line)
+{
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++)
+    {
+        if (kRowPins[r] == line) return (int8_t)r;
+    }
+    return -1;
+}
+
+static int8_t col_of(pin_t line)
+{
+    for (uint8_t c = 0; c < MATRIX_COLS; c++)
+    {
+        if (kColPins[c] == line) return (int8_t)c;
+    }
+    return -1;
+}
+
+// 입력 레벨: 출력 핀은 자기 출력, 매트릭스 입력은 눌린 키의 다이오드(컬럼 -> 행)를 거쳐 구동됨
+static bool pin_level(pin_t line)
+{
+    const sim_pin_t* p = pin_at(line);
+    if (p->mode == SIM_PIN_OUTPUT) return p->out;
+
+    const int8_t col = col_of(line);
+    if (col >= 0)
+    {
+        // 컬럼 입력: 눌린 키로 연결된 행이 LOW로 구동 중이면 LOW
+        for (uint8_t r = 0; r < MATRIX_ROWS; r++)
+        {
+            if ((s_phys[r] >> col) & 1u)
+            {
+                const sim_pin_t* rp = pin_at(kRowPins[r]);
+                if (rp->mode == SIM_PIN_OUTPUT && !rp->out) return false;
+            }
+        }
+        return p->mode != SIM_PIN_PULLDOWN;
+    }
+
+    const int8_t row = row_of(line);
+    if (row >= 0)
+    {
+        // 행 입력 (깊은 유휴): 눌린 키로 연결된 컬럼이 HIGH로 구동 중이면 HIGH
+        for (uint8_t c = 0; c < MATRIX_COLS; c++)
+        {
+            if ((s_phys[row] >> c) & 1u)
+            {
+                const sim_pin_t* cp = pin_at(kColPins[c]);
+                if (cp->mode == SIM_PIN_OUTPUT && cp->out) return true;
+            }
+        }
+    }
+    return p->mode == SIM_PIN_PULLUP;
+}
+
+// 이벤트가 켜진 핀의 상승 에지를 콜백으로 전달 (EXTI)
+static void check_line_events(void)
+{
+    for (uint8_t port = 0; port < SIM_PORT_COUNT; port++)
+    {
+        for (uint8_t pad = 0; pad < 16u; pad++)
+        {
+            sim_pin_t* p = &s_pins[port][pad];
+            if (!p->event) continue;
+            const bool level = pin_level(PAL_LINE(port, pad));
+            if (level && !p->event_level && p->callback) p->callback(p->arg);
+            p->event_level = level;
+        }
+    }
+}
+
+static void pin_write(pin_t line, bool level)
+{
+    sim_pin_t* p = pin_at(line);
+    g_sim_stats.pin_writes++;
+    if (p->out != level && s_history_count < SIM_PIN_HISTORY_MAX)
+    {
+        s_history[s_history_count++] = (sim_pin_change_t){ .us = g_sim_us, .pin = line, .level = level };
+    }
+    p->out = level;
+    check_line_events();
+}
+
+static void pin_mode(pin_t line, uint8_t mode)
+{
+    pin_at(line)->mode = mode;
+    check_line_events();
+}
+
+void setPinOutput(pin_t pin)
+{
+    pin_mode(pin, SIM_PIN_OUTPUT);
+}
+
+void setPinInputHigh(pin_t pin)
+{
+    pin_mode(pin, SIM_PIN_PULLUP);
+}
+
+void setPinInputLow(pin_t pin)
+{
+    pin_mode(pin, SIM_PIN_PULLDOWN);
+}
+
+void writePinHigh(pin_t pin)
+{
+    pin_write(pin, true);
+}
+
+void writePinLow(pin_t pin)
+{
+    pin_write(pin, false);
+}
+
+bool readPin(pin_t pin)
+{
+    g_sim_stats.pin_reads++;
+    return pin_level(pin);
+}
+
+ioportmask_t palReadPort(ioportid_t port)
+{
+    g_sim_stats.port_reads++;
+    ioportmask_t mask = 0;
+    for (uint8_t pad = 0; pad < 16u; pad++)
+    {
+        if (pin_level(PAL_LINE(port, pad))) mask |= (ioportmask_t)1u << pad;
+    }
+    return mask;
+}
+
+void palSetLineMode(ioline_t line, uint32_t mode)
+{
+    if (mode & 0x10u)
+    {
+        pin_mode(line, SIM_PIN_ALTERNATE);
+    }
+    else
+    {
+        pin_mode(line, (mode == PAL_MODE_INPUT_PULLDOWN) ? SIM_PIN_PULLDOWN : SIM_PIN_PULLUP);
+    }
+}
+
+void palEnableLineEvent(ioline_t line, uint32_t mode)
+{
+    sim_pin_t* p = pin_at(line);
+    p->event = true;
+    p->event_level = pin_level(line);
+}
+
+void palDisableLineEvent(ioline_t line)
+{
+    pin_at(line)->event = false;
+}
+
+void palSetLineCallback(ioline_t line, palcallback_t cb, void* arg)
+{
+    sim_pin_t* p = pin_at(line);
+    p->callback = cb;
+    p->arg = arg;
+}
+
+void chSysLock(void) {}
+
+void chSysUnlock(void) {}
+
+void __WFI(void)
+{
+    sim_advance_us((uint32_t)(1000u - g_sim_us % 1000u));
+}
+
+bool sim_pin_level(pin_t pin)
+{
+    return pin_level(pin);
+}
+
+void sim_pin_history_clear(void)
+{
+    s_history_count = 0;
+}
+
+size_t sim_pin_history_count(void)
+{
+    return s_history_count;
+}
+
+const sim_pin_change_t* sim_pin_history(size_t index)
+{
+    return (index < s_history_count) ? &s_history[index] : NULL;
+}
+
+void sim_key(uint8_t row, uint8_t col, bool down)
+{
+    if (down)
+    {
+        s_phys[row] |= (matrix_row_t)1u << col;
+    }
+    else
+    {
+        s_phys[row] &= ~((matrix_row_t)1u << col);
+    }
+    check_line_events();
+}
+
+// --- PWM / RCC ---
+
+static pwmcnt_t s_pwm_width[4];
+
+void pwmStart(PWMDriver* pwmp, const PWMConfig* config)
+{
+    pwmp->config = config;
+}
+
+void pwmStop(PWMDriver* pwmp)
+{
+    pwmp->config = NULL;
+}
+
+void pwmEnableChannel(PWMDriver* pwmp, pwmchannel_t channel, pwmcnt_t width)
+{
+    g_sim_stats.pwm_writes++;
+    if (channel < 4u) s_pwm_width[channel] = width;
+}
+
+uint32_t sim_pwm_width(uint8_t channel)
+{
+    return (channel < 4u) ? s_pwm_width[channel] : 0u;
+}
+
+void rccEnableTIM14(bool lp) {}
+
+// --- eeconfig / 동적 키맵 / VIA 영역 ---
+
+static bool s_ee_valid; // eeconfig 매직
+static uint32_t s_ee_kb;
+static uint8_t s_ee_kb_data[EECONFIG_KB_DATA_SIZE];
+
+static void ee_update(uint8_t* dst, const void* src, uint32_t length)
+{
+    const uint8_t* s = src;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        if (dst[i] != s[i]) g_sim_stats.eeprom_writes++;
+        dst[i] = s[i];
+    }
+}
+
+uint32_t eeconfig_read_kb(void)
+{
+    return s_ee_kb;
+}
+
+void eeconfig_update_kb(uint32_t val)
+{
+    ee_update((uint8_t*)&s_ee_kb, &val, sizeof(val));
+}
+
+bool eeconfig_is_kb_datablock_valid(void)
+{
+    return s_ee_kb == (EECONFIG_KB_DATA_VERSION);
+}
+
+// QMK와 같이 버전이 맞지 않으면 0으로 채워 돌려줌
+void eeconfig_read_kb_datablock(void* data, uint32_t offset, uint32_t length)
+{
+    if (!eeconfig_is_kb_datablock_valid() || offset + length > EECONFIG_KB_DATA_SIZE)
+    {
+        memset(data, 0, length);
+        return;
+    }
+    memcpy(data, &s_ee_kb_data[offset], length);
+}
+
+// QMK와 같이 쓸 때마다 kb 워드 자리에 데이터블록 버전을 기록
+void eeconfig_update_kb_datablock(const void* data, uint32_t offset, uint32_t length)
+{
+    const uint32_t version = EECONFIG_KB_DATA_VERSION;
+    ee_update((uint8_t*)&s_ee_kb, &version, sizeof(version));
+    if (offset + length > EECONFIG_KB_DATA_SIZE) return;
+    ee_update(&s_ee_kb_data[offset], data, length);
+}
+
+uint32_t sim_eeprom_kb_word(void)
+{
+    return s_ee_kb;
+}
+
+const uint8_t* sim_eeprom_kb_datablock(void)
+{
+    return s_ee_kb_data;
+}
+
+__attribute__((weak)) void eeconfig_init_user(void) {}
+
+__attribute__((weak)) void matrix_init_user(void) {}
+
+#ifdef VIA_ENABLE
+static bool s_via_valid;
+static uint16_t s_dynamic_keymap[DYNAMIC_KEYMAP_LAYER_COUNT][MATRIX_ROWS][MATRIX_COLS];
+
+uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
+{
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+    return s_dynamic_keymap[layer][row][column];
+}
+
+void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode)
+{
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
+    ee_update((uint8_t*)&s_dynamic_keymap[layer][row][column], &keycode, sizeof(keycode));
+}
+
+// QMK dynamic_keymap_reset: keymaps[]에 있는 레이어는 그대로, 나머지는 KC_TRNS
+void dynamic_keymap_reset(void)
+{
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++)
+    {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+        {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++)
+            {
+                dynamic_keymap_set_keycode(layer, row, col, keycode_at_keymap_location_raw(layer, row, col));
+            }
+        }
+    }
+}
+
+// QMK dynamic_keymap_set_buffer: 키맵 시작부터의 바이트 오프셋, 키코드는 빅 엔디언.
+// 바이트마다 eeprom_update_byte이므로 바뀐 바이트만 쓰기로 셈
+void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t* data)
+{
+    for (uint16_t i = 0; i < size; i++)
+    {
+        const uint32_t pos = (uint32_t)offset + i;
+        if (pos >= sizeof(s_dynamic_keymap)) return;
+        uint16_t* cell = &((uint16_t*)s_dynamic_keymap)[pos / 2u];
+        uint16_t keycode = *cell;
+        if (pos % 2u == 0)
+        {
+            keycode = (uint16_t)((keycode & 0x00FFu) | (data[i] << 8));
+        }
+        else
+        {
+            keycode = (uint16_t)((keycode & 0xFF00u) | data[i]);
+        }
+        ee_update((uint8_t*)cell, &keycode, sizeof(keycode));
+    }
+}
+
+void dynamic_keymap_macro_reset(void) {}
+
+void via_set_layout_options(uint32_t value)
+{
+    (void)value;
+}
+
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column)
+{
+    return dynamic_keymap_get_keycode(layer_num, row, column);
+}
+
+bool via_eeprom_is_valid(void)
+{
+    return s_via_valid;
+}
+
+void via_eeprom_set_valid(bool valid)
+{
+    s_via_valid = valid;
+}
+
+void eeconfig_init_via(void)
+{
+    via_eeprom_set_valid(false);
+    via_set_layout_options(VIA_EEPROM_LAYOUT_OPTIONS_DEFAULT);
+    dynamic_keymap_reset();
+    dynamic_keymap_macro_reset();
+    via_eeprom_set_valid(true);
+}
+
+__attribute__((weak)) void via_init_kb(void) {}
+
+__attribute__((weak)) bool via_command_kb(uint8_t* data, uint8_t length)
+{
+    return false;
+}
+
+static void via_init(void)
+{
+    via_init_kb();
+    if (!via_eeprom_is_valid()) eeconfig_init_via();
+}
+
+void raw_hid_send(uint8_t* data, uint8_t length)
+{
+    memcpy(g_sim_raw_hid_response, data, (length < sizeof(g_sim_raw_hid_response)) ? length : sizeof(g_sim_raw_hid_response));
+}
+
+// QMK raw_hid_receive (via.c) 중 보드 모듈이 다루는 명령만
+void sim_via(uint8_t* data, uint8_t length)
+{
+    if (via_command_kb(data, length)) return;
+    switch (data[0])
+    {
+        case id_custom_set_value:
+        case id_custom_get_value:
+        case id_custom_save:
+            via_custom_value_command_kb(data, length);
+            break;
+        case id_dynamic_keymap_set_keycode:
+            dynamic_keymap_set_keycode(data[1], data[2], data[3], (uint16_t)((data[4] << 8) | data[5]));
+            break;
+        case id_dynamic_keymap_reset:
+            dynamic_keymap_reset();
+            break;
+        case id_eeprom_reset:
+            via_eeprom_set_valid(false);
+            eeconfig_init_via();
+            break;
+        default:
+            data[0] = id_unhandled;
+            break;
+    }
+    raw_hid_send(data, length);
+}
+#endif
+
+void sim_eeprom_erase(void)
+{
+    s_ee_valid = false;
+    s_ee_kb = 0;
+    memset(s_ee_kb_data, 0, sizeof(s_ee_kb_data));
+#ifdef VIA_ENABLE
+    s_via_valid = false;
+    memset(s_dynamic_keymap, 0, sizeof(s_dynamic_keymap));
+#endif
+}
+
+// QMK eeconfig_init_quantum 중 kb 관련 부분 (데이터블록 초기화 -> VIA/동적 키맵 -> eeconfig_init_kb)
+static void eeconfig_init_quantum(void)
+{
+    static const uint8_t kZero[EECONFIG_KB_DATA_SIZE] = { 0 };
+    eeconfig_update_kb_datablock(kZero, 0, sizeof(kZero));
+#ifdef VIA_ENABLE
+    eeconfig_init_via();
+#endif
+    eeconfig_init_kb();
+    s_ee_valid = true;
+}
+
+// --- OS 감지 / 호스트 LED ---
+
+static os_variant_t s_detected_os = OS_UNSURE;
+static led_t s_host_leds;
+
+os_variant_t detected_host_os(void)
+{
+    return s_detected_os;
+}
+
+void sim_set_detected_os(os_variant_t os)
+{
+    s_detected_os = os;
+    process_detected_host_os_user(os);
+}
+
+led_t host_keyboard_led_state(void)
+{
+    return s_host_leds;
+}
+
+void sim_set_host_leds(uint8_t raw)
+{
+    if (s_host_leds.raw == raw) return;
+    s_host_leds.raw = raw;
+    led_update_user(s_host_leds);
+}
+
+// --- 보고서 상태 (FORCE_NKRO) ---
+
+static uint8_t s_mods;
+static uint8_t s_weak_mods;
+static uint8_t s_keys[NKRO_REPORT_BITS];
+static report_nkro_t s_last_report;
+static bool s_report_sent;
+
+uint8_t get_mods(void)
+{
+    return s_mods;
+}
+
+void add_mods(uint8_t mods)
+{
+    s_mods |= mods;
+}
+
+void del_mods(uint8_t mods)
+{
+    s_mods &= (uint8_t)~mods;
+}
+
+void add_weak_mods(uint8_t mods)
+{
+    s_weak_mods |= mods;
+}
+
+void del_weak_mods(uint8_t mods)
+{
+    s_weak_mods &= (uint8_t)~mods;
+}
+
+void clear_weak_mods(void)
+{
+    s_weak_mods = 0;
+}
+
+void add_key(uint8_t key)
+{
+    if (key < NKRO_REPORT_BITS * 8u) s_keys[key >> 3] |= (uint8_t)(1u << (key & 7u));
+}
+
+void del_key(uint8_t key)
+{
+    if (key < NKRO_REPORT_BITS * 8u) s_keys[key >> 3] &= (uint8_t)~(1u << (key & 7u));
+}
+
+// QMK와 같이 직전 보고서와 같으면 보내지 않음
+void send_keyboard_report(void)
+{
+    report_nkro_t report = { .report_id = 0, .mods = (uint8_t)(s_mods | s_weak_mods) };
+    memcpy(report.bits, s_keys, sizeof(report.bits));
+    if (s_report_sent && memcmp(&report, &s_last_report, sizeof(report)) == 0) return;
+    s_last_report = report;
+    s_report_sent = true;
+    if (s_host_driver) s_host_driver->send_nkro(&report);
+}
+
+void register_code(uint8_t code)
+{
+    if (code >= KC_LCTL && code <= KC_RGUI)
+    {
+        add_mods(MOD_BIT(code));
+    }
+    else
+    {
+        add_key(code);
+    }
+    send_keyboard_report();
+}
+
+void unregister_code(uint8_t code)
+{
+    if (code >= KC_LCTL && code <= KC_RGUI)
+    {
+        del_mods(MOD_BIT(code));
+    }
+    else
+    {
+        del_key(code);
+    }
+    send_keyboard_report();
+}
+
+// --- 키 이벤트 경로 ---
+
+static matrix_row_t s_raw[MATRIX_ROWS];
+static matrix_row_t s_matrix[MATRIX_ROWS];
+static matrix_row_t s_matrix_prev[MATRIX_ROWS];
+static uint32_t s_last_activity_ms;
+static uint8_t s_source_layer[MATRIX_ROWS][MATRIX_COLS];
+
+matrix_row_t matrix_get_row(uint8_t row)
+{
+    return s_matrix[row];
+}
+
+uint32_t last_input_activity_elapsed(void)
+{
+    return now_ms() - s_last_activity_ms;
+}
+
+__attribute__((weak)) uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key)
+{
+    return keycode_at_keymap_location(layer, key.row, key.col);
+}
+
+static uint8_t layer_for_press(keypos_t key)
+{
+    for (int8_t layer = 31; layer > 0; layer--)
+    {
+        if ((layer_state >> layer) & 1u)
+        {
+            if (keymap_key_to_keycode((uint8_t)layer, key) != KC_TRNS) return (uint8_t)layer;
+        }
+    }
+    return 0;
+}
+
+// 5비트 QMK 모디파이어(bit 4 = 오른쪽) -> 8비트 HID 모디파이어
+static uint8_t mod_config_to_bits(uint8_t mods)
+{
+    return (mods & 0x10u) ? (uint8_t)((mods & 0x0Fu) << 4) : (uint8_t)(mods & 0x0Fu);
+}
+
+// 기본 키 / 모디파이어 / 모디파이어 조합 / MO만 처리. 탭-홀드(LT, MT)는 시뮬레이션하지 않음
+static void process_action(uint16_t keycode, bool pressed)
+{
+    if (pressed) clear_weak_mods();
+
+    if (keycode >= KC_A && keycode <= KC_RGUI)
+    {
+        if (pressed) { register_code((uint8_t)keycode); } else { unregister_code((uint8_t)keycode); }
+    }
+    else if (keycode >= QK_MODS && keycode < QK_MOD_TAP)
+    {
+        const uint8_t mods = mod_config_to_bits((uint8_t)((keycode >> 8) & 0x1Fu));
+        if (pressed)
+        {
+            add_weak_mods(mods);
+            register_code((uint8_t)keycode);
+        }
+        else
+        {
+            del_weak_mods(mods);
+            unregister_code((uint8_t)keycode);
+        }
+    }
+    else if ((keycode & 0xFFE0u) == QK_MOMENTARY)
+    {
+        const layer_state_t bit = (layer_state_t)1u << (keycode & 0x1Fu);
+        if (pressed) { layer_state |= bit; } else { layer_state &= ~bit; }
+    }
+}
+
+static sim_press_t* s_presses;
+static size_t s_press_count;
+static size_t s_press_cap;
+
+static void record_press(keypos_t key, uint16_t keycode)
+{
+    if (s_press_count == s_press_cap)
+    {
+        s_press_cap = s_press_cap ? s_press_cap * 2u : 256u;
+        s_presses = realloc(s_presses, s_press_cap * sizeof(*s_presses));
+        if (s_presses == NULL) abort();
+    }
+    s_presses[s_press_count++] = (sim_press_t){ .us = g_sim_us, .key = key, .keycode = keycode };
+}
+
+size_t sim_press_count(void)
+{
+    return s_press_count;
+}
+
+const sim_press_t* sim_press(size_t index)
+{
+    return (index < s_press_count) ? &s_presses[index] : NULL;
+}
+
+void sim_presses_clear(void)
+{
+    s_press_count = 0;
+}
+
+void process_record(keyrecord_t* record)
+{
+    const keypos_t key = record->event.key;
+    if (record->event.pressed) s_source_layer[key.row][key.col] = layer_for_press(key);
+    const uint16_t keycode = keymap_key_to_keycode(s_source_layer[key.row][key.col], key);
+    record->keycode = keycode;
+    if (record->event.pressed) record_press(key, keycode);
+    const uint64_t start = profile_begin();
+    const bool cont = process_record_user(keycode, record);
+    profile_end(SIM_SECTION_PROCESS_RECORD, start);
+    if (!cont) return;
+    process_action(keycode, record->event.pressed);
+}
+
+// QMK matrix_task: 스캔 -> 디바운스 -> 바뀐 키마다 이벤트 (행/열 순서)
+static void matrix_task(void)
+{
+    const uint64_t start = profile_begin();
+    const bool changed = matrix_scan_custom(s_raw);
+    profile_end(SIM_SECTION_SCAN, start);
+    debounce(s_raw, s_matrix, MATRIX_ROWS, changed);
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+    {
+        const matrix_row_t diff = s_matrix[row] ^ s_matrix_prev[row];
+        if (diff == 0) continue;
+        s_last_activity_ms = now_ms();
+        for (uint8_t col = 0; col < MATRIX_COLS; col++)
+        {
+            const matrix_row_t bit = (matrix_row_t)1u << col;
+            if ((diff & bit) == 0) continue;
+            s_matrix_prev[row] ^= bit;
+            keyrecord_t record = {
+                .event = {
+                    .key     = { .col = col, .row = row },
+                    .time    = (uint16_t)(now_ms() | 1u),
+                    .type    = 1,
+                    .pressed = (s_matrix[row] & bit) != 0,
+                },
+            };
+            process_record(&record);
+        }
+    }
+}
+
+void sim_task(void)
+{
+    matrix_task();
+    const uint64_t start = profile_begin();
+    housekeeping_task_user();
+    profile_end(SIM_SECTION_HOUSEKEEPING, start);
+    sim_advance_us(g_sim_loop_us);
+}
+
+void sim_run_ms(uint32_t ms)
+{
+    const uint64_t target = g_sim_us + (uint64_t)ms * 1000u;
+    while (g_sim_us < target) sim_task();
+}
+
+void sim_boot(void)
+{
+    USBD1.state = USB_STOP;
+    s_host_driver = NULL;
+    layer_state = 0;
+    s_mods = 0;
+    s_weak_mods = 0;
+    memset(s_keys, 0, sizeof(s_keys));
+    s_report_sent = false;
+    memset(s_raw, 0, sizeof(s_raw));
+    memset(s_matrix, 0, sizeof(s_matrix));
+    memset(s_matrix_prev, 0, sizeof(s_matrix_prev));
+    s_last_activity_ms = now_ms();
+
+#ifdef VIA_ENABLE
+    via_init();
+#endif
+    matrix_init_custom();
+    debounce_init(MATRIX_ROWS);
+    matrix_init_kb();
+    if (!s_ee_valid) eeconfig_init_quantum();
+    keyboard_post_init_user();
+
+    // protocol_post_init: 호스트 드라이버 설정, 이후 호스트가 USB 구성을 마침
+    host_set_driver(&s_sim_driver);
+    USBD1.state = USB_ACTIVE;
+}
@@ -0,0 +1,112 @@
+// 900than9 호스트 시뮬레이션: 가상 시계/핀/eeconfig/USB 폴링과 최소한의 QMK 이벤트 경로
+// 보드 모듈(my_*.c)과 키맵은 수정 없이 stub/ 헤더에 대고 컴파일해서 이 파일의 API로 구동함
+#pragma once
+
+#include "quantum.h"
+#include "host.h"
+#include "os_detection.h"
+
+// --- 가상 시계 ---
+// timer_read32() = g_sim_us / 1000, TIM14 CNT = g_sim_us 하위 16비트
+extern uint64_t g_sim_us;
+// 메인 루프 한 바퀴(keyboard_task + housekeeping)에 걸리는 시간
+extern uint32_t g_sim_loop_us;
+
+// 시계 진행. 1ms 경계마다 USB 폴링이 한 번 일어나 대기 중인 보고서 하나를 호스트로 넘김
+void sim_advance_us(uint32_t us);
+
+// --- 스텁 호출 횟수 (벤치마크/회귀 판정용). sim 코어 내부 호출은 세지 않음 ---
+typedef struct {
+    uint64_t pin_writes;    // writePinHigh / writePinLow
+    uint64_t pin_reads;     // readPin
+    uint64_t port_reads;    // palReadPort
+    uint64_t pwm_writes;    // pwmEnableChannel
+    uint64_t timer_reads;   // timer_read / timer_read32
+    uint64_t timer_elapsed; // timer_elapsed / timer_elapsed32
+    uint64_t eeprom_writes; // eeconfig / 동적 키맵에서 실제로 바뀐 바이트 수
+    uint64_t reports;       // 호스트 드라이버로 나간 키보드 보고서
+} sim_stats_t;
+
+extern sim_stats_t g_sim_stats;
+
+// --- 구간별 호스트 실행 시간 (벤치마크용, g_sim_profile이 켜져 있을 때만 잼) ---
+enum sim_section {
+    SIM_SECTION_SCAN = 0,        // matrix_scan_custom
+    SIM_SECTION_HOUSEKEEPING,    // housekeeping_task_user
+    SIM_SECTION_PROCESS_RECORD,  // process_record_user
+    SIM_SECTION_COUNT
+};
+
+typedef struct {
+    uint64_t calls;
+    uint64_t ns; // CLOCK_MONOTONIC, 측정 자체의 비용 포함
+} sim_section_t;
+
+extern bool g_sim_profile;
+extern sim_section_t g_sim_sections[SIM_SECTION_COUNT];
+
+// --- 보드 ---
+// QMK keyboard_init 순서로 초기화 (VIA -> 매트릭스 -> eeconfig 검사 -> post_init -> 호스트 드라이버)
+// EEPROM 내용은 유지되므로 두 번 부르면 재부팅과 같음
+void sim_boot(void);
+// EEPROM을 지워 다음 sim_boot에서 eeconfig / VIA 초기화가 일어나게 함
+void sim_eeprom_erase(void);
+// 메인 루프 한 바퀴를 돌고 g_sim_loop_us만큼 시계 진행
+void sim_task(void);
+void sim_run_ms(uint32_t ms);
+
+// 물리 키 상태 (다이오드 COL2ROW). 다음 스캔에서 읽힘
+void sim_key(uint8_t row, uint8_t col, bool down);
+// OS 감지 결과 지정 (process_detected_host_os_user까지 호출)
+void sim_set_detected_os(os_variant_t os);
+// 호스트 LED 상태 변경 (led_update_user까지 호출)
+void sim_set_host_leds(uint8_t raw);
+// VIA raw HID 패킷 처리. 응답은 같은 버퍼에 쓰이고 g_sim_raw_hid_response에도 남음
+void sim_via(uint8_t* data, uint8_t length);
+extern uint8_t g_sim_raw_hid_response[32];
+
+// EEPROM 원본 (eeconfig kb 워드 / kb 데이터블록 / 동적 키맵)
+uint32_t sim_eeprom_kb_word(void);
+const uint8_t* sim_eeprom_kb_datablock(void);
+
+// --- 핀 ---
+bool sim_pin_level(pin_t pin);
+// LED PWM 채널 듀티 (pwmEnableChannel 마지막 값)
+uint32_t sim_pwm_width(uint8_t channel);
+
+// 출력 레벨이 바뀔 때마다 기록 (가득 차면 기록 중단)
+typedef struct {
+    uint64_t us;
+    pin_t    pin;
+    bool     level;
+} sim_pin_change_t;
+
+void sim_pin_history_clear(void);
+size_t sim_pin_history_count(void);
+const sim_pin_change_t* sim_pin_history(size_t index);
+
+// --- 키보드 보고서 (호스트 드라이버가 받은 순서) ---
+typedef struct {
+    uint64_t sent_us;      // 호스트 드라이버 호출 시각
+    uint64_t delivered_us; // USB 폴링으로 호스트가 가져간 시각 (0 = 아직 대기 중)
+    uint8_t  mods;
+    uint8_t  bits[NKRO_REPORT_BITS];
+} sim_report_t;
+
+size_t sim_report_count(void);
+const sim_report_t* sim_report(size_t index);
+void sim_reports_clear(void);
+bool sim_report_has_key(const sim_report_t* report, uint8_t keycode);
+uint8_t sim_report_key_count(const sim_report_t* report);
+
+// --- process_record가 받은 누름 (누른 시점의 레이어로 해석한 키코드) ---
+// 재생 보류(my_keycode_defer_record)된 이벤트는 다시 들어올 때 한 번 더 기록됨
+typedef struct {
+    uint64_t us;
+    keypos_t key;
+    uint16_t keycode;
+} sim_press_t;
+
+size_t sim_press_count(void);
+const sim_press_t* sim_press(size_t index);
+void sim_presses_clear(void);
@@ -0,0 +1,7 @@
+// 호스트 시뮬레이션용 debounce.h 대체
+#pragma once
+
+#include "quantum.h"
+
+void debounce_init(uint8_t num_rows);
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
@@ -0,0 +1,10 @@
+// 호스트 시뮬레이션용 dynamic_keymap.h 대체 (구현: test/sim.c)
+#pragma once
+
+#include <stdint.h>
+
+uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column);
+void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode);
+void dynamic_keymap_reset(void);
+void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t* data);
+void dynamic_keymap_macro_reset(void);
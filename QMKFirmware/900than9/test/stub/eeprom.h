@@ -0,0 +1,2 @@
+// 호스트 시뮬레이션용 eeprom.h 대체 (eeconfig는 quantum.h에 선언)
+#pragma once
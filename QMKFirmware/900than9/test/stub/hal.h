@@ -0,0 +1,85 @@
+// 호스트 시뮬레이션용 ChibiOS hal.h 대체: PAL(GPIO)/PWM/시스템 락 일부만 제공
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// 라인 = (포트 번호 << 8) | 패드. 실제 ChibiOS는 포트 주소 | 패드지만 모듈은 PAL_PORT/PAL_PAD로만 분해함
+typedef uint32_t ioline_t;
+typedef uint32_t ioportid_t;
+typedef uint32_t ioportmask_t;
+
+#define PAL_LINE(port, pad) ((ioline_t)(((port) << 8) | (pad)))
+#define PAL_PORT(line)      ((ioportid_t)((line) >> 8))
+#define PAL_PAD(line)       ((uint8_t)((line) & 0xFFu))
+
+#define SIM_PORT_A 1u
+#define SIM_PORT_B 2u
+#define SIM_PORT_C 3u
+#define SIM_PORT_F 6u
+#define SIM_PORT_COUNT 7u
+
+// clang-format off
+enum sim_pin_lines {
+    A0 = PAL_LINE(SIM_PORT_A, 0), A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15,
+    B0 = PAL_LINE(SIM_PORT_B, 0), B1, B2, B3, B4, B5, B6, B7, B8, B9, B10, B11, B12, B13, B14, B15,
+    C13 = PAL_LINE(SIM_PORT_C, 13), C14, C15,
+    F0 = PAL_LINE(SIM_PORT_F, 0), F1,
+};
+// clang-format on
+
+#define PAL_MODE_INPUT_PULLUP      2u
+#define PAL_MODE_INPUT_PULLDOWN    3u
+#define PAL_MODE_ALTERNATE(n)      (0x10u | (n))
+#define PAL_EVENT_MODE_RISING_EDGE 1u
+
+typedef void (*palcallback_t)(void* arg);
+
+ioportmask_t palReadPort(ioportid_t port);
+void palSetLineMode(ioline_t line, uint32_t mode);
+void palEnableLineEvent(ioline_t line, uint32_t mode);
+void palDisableLineEvent(ioline_t line);
+void palSetLineCallback(ioline_t line, palcallback_t cb, void* arg);
+
+// WFI는 다음 인터럽트(시스템 틱 = 다음 ms 경계)까지 가상 시계를 진행시킴
+void chSysLock(void);
+void chSysUnlock(void);
+void __WFI(void);
+
+// --- PWM ---
+typedef uint8_t  pwmchannel_t;
+typedef uint32_t pwmcnt_t;
+typedef struct PWMDriver PWMDriver;
+typedef void (*pwmcallback_t)(PWMDriver* pwmp);
+
+typedef struct {
+    uint32_t      mode;
+    pwmcallback_t callback;
+} PWMChannelConfig;
+
+typedef struct {
+    uint32_t         frequency;
+    pwmcnt_t         period;
+    pwmcallback_t    callback;
+    PWMChannelConfig channels[4];
+    uint32_t         cr2;
+    uint32_t         dier;
+} PWMConfig;
+
+struct PWMDriver {
+    const PWMConfig* config;
+};
+
+extern PWMDriver PWMD3;
+
+#define PWM_OUTPUT_DISABLED    0u
+#define PWM_OUTPUT_ACTIVE_HIGH 1u
+
+void pwmStart(PWMDriver* pwmp, const PWMConfig* config);
+void pwmStop(PWMDriver* pwmp);
+void pwmEnableChannel(PWMDriver* pwmp, pwmchannel_t channel, pwmcnt_t width);
+
+// --- RCC (stm32_rcc.h) ---
+#define STM32_TIMCLK1 48000000u
+void rccEnableTIM14(bool lp);
@@ -0,0 +1,28 @@
+// 호스트 시뮬레이션용 host.h 대체: 보고서는 sim.c의 호스트 드라이버가 USB 폴링 큐에 넣음
+#pragma once
+
+#include <stdint.h>
+
+#define KEYBOARD_REPORT_KEYS 6
+#define NKRO_REPORT_BITS     30
+
+typedef struct {
+    uint8_t mods;
+    uint8_t reserved;
+    uint8_t keys[KEYBOARD_REPORT_KEYS];
+} report_keyboard_t;
+
+typedef struct {
+    uint8_t report_id;
+    uint8_t mods;
+    uint8_t bits[NKRO_REPORT_BITS];
+} report_nkro_t;
+
+typedef struct {
+    uint8_t (*keyboard_leds)(void);
+    void (*send_keyboard)(report_keyboard_t* report);
+    void (*send_nkro)(report_nkro_t* report);
+} host_driver_t;
+
+host_driver_t* host_get_driver(void);
+void host_set_driver(host_driver_t* driver);
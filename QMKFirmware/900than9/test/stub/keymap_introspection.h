@@ -0,0 +1,8 @@
+// 호스트 시뮬레이션용 keymap_introspection.h 대체 (구현: test/keymap_introspection.c, sim.c)
+#pragma once
+
+#include <stdint.h>
+
+uint8_t keymap_layer_count(void);
+uint16_t keycode_at_keymap_location_raw(uint8_t layer_num, uint8_t row, uint8_t column);
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column);
@@ -0,0 +1,7 @@
+// 호스트 시뮬레이션용 matrix.h 대체 (CUSTOM_MATRIX = lite)
+#pragma once
+
+#include "quantum.h"
+
+void matrix_init_custom(void);
+bool matrix_scan_custom(matrix_row_t current_matrix[]);
@@ -0,0 +1,15 @@
+// 호스트 시뮬레이션용 os_detection.h 대체: 감지 결과는 sim_set_detected_os로 지정
+#pragma once
+
+#include <stdbool.h>
+
+typedef enum {
+    OS_UNSURE,
+    OS_LINUX,
+    OS_WINDOWS,
+    OS_MACOS,
+    OS_IOS,
+} os_variant_t;
+
+os_variant_t detected_host_os(void);
+bool process_detected_host_os_user(os_variant_t detected_os);
@@ -0,0 +1,184 @@
+// 호스트 시뮬레이션용 QMK 헤더 대체 (test/Makefile)
+// 보드 모듈이 쓰는 QMK/ChibiOS API만 선언하고 구현은 test/sim.c에 둠. 키코드/구조체 값은 QMK와 같게 맞춤
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "config.h"
+#include "hal.h"
+
+// --- 보드 정의 (keyboard.json에서 생성되는 값) ---
+#define MATRIX_ROWS     6
+#define MATRIX_COLS     18
+#define MATRIX_ROW_PINS { A14, A15, B3, B4, B5, B6 }
+#define MATRIX_COL_PINS { B11, B10, B2, B1, A5, A4, A3, B15, B14, B13, B12, A2, A1, F1, F0, C15, C14, C13 }
+
+#define PROGMEM
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define ARRAY_SIZE(a)    (sizeof(a) / sizeof((a)[0]))
+
+// --- 타이머: sim.c의 가상 시계 (ms) ---
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+uint16_t timer_elapsed(uint16_t last);
+uint32_t timer_elapsed32(uint32_t last);
+#define timer_expired32(current, future) ((uint32_t)((current) - (future)) < UINT32_MAX / 2)
+
+// --- GPIO: sim.c의 가상 핀 ---
+typedef ioline_t pin_t;
+void setPinOutput(pin_t pin);
+void setPinInputHigh(pin_t pin);
+void setPinInputLow(pin_t pin);
+void writePinHigh(pin_t pin);
+void writePinLow(pin_t pin);
+bool readPin(pin_t pin);
+static inline void writePin(pin_t pin, bool level)
+{
+    if (level) { writePinHigh(pin); } else { writePinLow(pin); }
+}
+static inline void waitInputPinDelay(void) {}
+
+// --- 키코드 (QMK keycodes.h와 같은 값) ---
+enum qk_keycode_defines {
+    KC_NO = 0x0000,
+    KC_TRNS,
+    KC_A = 0x0004, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M,
+    KC_N, KC_O, KC_P, KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W, KC_X, KC_Y, KC_Z,
+    KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0,
+    KC_ENT, KC_ESC, KC_BSPC, KC_TAB, KC_SPC, KC_MINS, KC_EQL, KC_LBRC, KC_RBRC, KC_BSLS, KC_NUHS,
+    KC_SCLN, KC_QUOT, KC_GRV, KC_COMM, KC_DOT, KC_SLSH, KC_CAPS,
+    KC_F1, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7, KC_F8, KC_F9, KC_F10, KC_F11, KC_F12,
+    KC_PSCR, KC_SCRL, KC_PAUS, KC_INS, KC_HOME, KC_PGUP, KC_DEL, KC_END, KC_PGDN,
+    KC_RGHT, KC_LEFT, KC_DOWN, KC_UP,
+    KC_EXSEL = 0x00A4,
+    KC_LCTL = 0x00E0, KC_LSFT, KC_LALT, KC_LGUI, KC_RCTL, KC_RSFT, KC_RALT, KC_RGUI,
+    QK_MODS          = 0x0100,
+    QK_MODS_MAX      = 0x1FFF,
+    QK_MOD_TAP       = 0x2000,
+    QK_LAYER_TAP     = 0x4000,
+    QK_TO            = 0x5200,
+    QK_MOMENTARY     = 0x5220,
+    QK_KB_0          = 0x7E00,
+};
+#define XXXXXXX  KC_NO
+#define _______  KC_TRNS
+#define KC_SPACE KC_SPC
+#define KC_RIGHT KC_RGHT
+
+#define MOD_LCTL 0x01
+#define MOD_LSFT 0x02
+#define MOD_LALT 0x04
+#define MOD_LGUI 0x08
+#define MOD_RSFT 0x12
+#define MOD_BIT(kc) ((uint8_t)(1u << ((kc) & 0x07)))
+
+#define IS_BASIC_KEYCODE(code)        ((code) >= KC_A && (code) <= KC_EXSEL)
+#define IS_MODIFIER_KEYCODE(code)     ((code) >= KC_LCTL && (code) <= KC_RGUI)
+#define IS_QK_MODS(code)              ((code) >= QK_MODS && (code) <= QK_MODS_MAX)
+#define QK_MODS_GET_BASIC_KEYCODE(kc) ((uint8_t)((kc) & 0xFF))
+
+#define LSFT(kc)        (QK_MODS | (MOD_LSFT << 8) | (kc))
+#define MT(mod, kc)     (QK_MOD_TAP | (((mod) & 0x1F) << 8) | ((kc) & 0xFF))
+#define CTL_T(kc)       MT(MOD_LCTL, kc)
+#define ALT_T(kc)       MT(MOD_LALT, kc)
+#define GUI_T(kc)       MT(MOD_LGUI, kc)
+#define LSFT_T(kc)      MT(MOD_LSFT, kc)
+#define RSFT_T(kc)      MT(MOD_RSFT, kc)
+#define LT(layer, kc)   (QK_LAYER_TAP | (((layer) & 0xF) << 8) | ((kc) & 0xFF))
+#define TO(layer)       (QK_TO | ((layer) & 0x1F))
+#define MO(layer)       (QK_MOMENTARY | ((layer) & 0x1F))
+
+#define LAYOUT(k0, k1, k2, k3, k4, k5, k6, k7, k8, k9, k10, k11, k12, k13, k14, k15, k16, k17, k18, k19, k20, k21, k22, k23, k24, k25, k26, k27, k28, k29, k30, k31, k32, k33, k34, k35, k36, k37, k38, k39, k40, k41, k42, k43, k44, k45, k46, k47, k48, k49, k50, k51, k52, k53, k54, k55, k56, k57, k58, k59, k60, k61, k62, k63, k64, k65, k66, k67, k68, k69, k70, k71, k72, k73, k74, k75, k76, k77, k78, k79, k80, k81, k82, k83, k84, k85, k86, k87, k88, k89, k90, k91, k92, k93, k94) \
+{ \
+    { k0, KC_NO, k1, k2, k3, k4, k5, k6, k7, k8, KC_NO, k9, k10, k11, k12, k13, k14, k15 }, \
+    { k16, k17, k18, k19, k20, k21, k22, k23, k24, k25, k26, k27, k28, k29, k30, k31, k32, k33 }, \
+    { k34, k35, k36, k37, k38, k39, k40, k41, k42, k43, k44, k45, k46, k47, KC_NO, k48, k49, k50 }, \
+    { k51, KC_NO, k52, k53, k54, k55, k56, k57, k58, k59, k60, k61, k62, k63, k64, KC_NO, KC_NO, KC_NO }, \
+    { k65, k66, k67, k68, k69, k70, k71, k72, k73, k74, k75, k76, KC_NO, k77, k78, KC_NO, k79, KC_NO }, \
+    { k80, k81, k82, k83, k84, k85, KC_NO, k86, KC_NO, k87, k88, KC_NO, k89, k90, k91, k92, k93, k94 } \
+}
+
+// --- 매트릭스 / 액션 ---
+typedef uint32_t matrix_row_t;
+typedef uint32_t layer_state_t;
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+typedef struct {
+    keypos_t key;
+    uint16_t time;
+    uint8_t  type;
+    bool     pressed;
+} keyevent_t;
+
+typedef struct {
+    keyevent_t event;
+    uint16_t   keycode;
+} keyrecord_t;
+
+extern layer_state_t layer_state;
+
+matrix_row_t matrix_get_row(uint8_t row);
+uint32_t last_input_activity_elapsed(void);
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
+// 레이어 해석 뒤 process_record_user -> 기본 동작 (탭/홀드 판정 없음)
+void process_record(keyrecord_t* record);
+
+// --- 보고서 (FORCE_NKRO) ---
+uint8_t get_mods(void);
+void add_mods(uint8_t mods);
+void del_mods(uint8_t mods);
+void add_weak_mods(uint8_t mods);
+void del_weak_mods(uint8_t mods);
+void clear_weak_mods(void);
+void add_key(uint8_t key);
+void del_key(uint8_t key);
+void send_keyboard_report(void);
+void register_code(uint8_t code);
+void unregister_code(uint8_t code);
+
+typedef union {
+    uint8_t raw;
+    struct {
+        bool    num_lock : 1;
+        bool    caps_lock : 1;
+        bool    scroll_lock : 1;
+        bool    compose : 1;
+        bool    kana : 1;
+        uint8_t reserved : 3;
+    };
+} led_t;
+
+led_t host_keyboard_led_state(void);
+
+// --- eeconfig (EECONFIG_KB_DATA_SIZE > 0: kb 워드 자리에 데이터블록 버전이 기록됨) ---
+#ifndef EECONFIG_KB_DATA_VERSION
+#    define EECONFIG_KB_DATA_VERSION (EECONFIG_KB_DATA_SIZE)
+#endif
+uint32_t eeconfig_read_kb(void);
+void eeconfig_update_kb(uint32_t val);
+void eeconfig_read_kb_datablock(void* data, uint32_t offset, uint32_t length);
+void eeconfig_update_kb_datablock(const void* data, uint32_t offset, uint32_t length);
+bool eeconfig_is_kb_datablock_valid(void);
+
+// --- 키보드/키맵 훅 (QMK가 weak로 정의, 보드/키맵이 재정의) ---
+void eeconfig_init_kb(void);
+void eeconfig_init_user(void);
+void matrix_init_kb(void);
+void matrix_init_user(void);
+void keyboard_post_init_user(void);
+void housekeeping_task_user(void);
+bool process_record_user(uint16_t keycode, keyrecord_t* record);
+bool led_update_user(led_t led_state);
+void suspend_power_down_user(void);
+void suspend_wakeup_init_user(void);
+
+#ifdef VIA_ENABLE
+#    include "via.h"
+#endif
@@ -0,0 +1,6 @@
+// 호스트 시뮬레이션용 raw_hid.h 대체: 응답은 sim.c가 기록
+#pragma once
+
+#include <stdint.h>
+
+void raw_hid_send(uint8_t* data, uint8_t length);
@@ -0,0 +1,18 @@
+// 호스트 시뮬레이션용 ChibiOS stm32_tim.h 대체: TIM14 CNT는 가상 us 시계의 하위 16비트
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+    volatile uint32_t EGR;
+    volatile uint32_t CNT;
+} stm32_tim_t;
+
+extern stm32_tim_t g_sim_tim14;
+
+#define STM32_TIM14       (&g_sim_tim14)
+#define STM32_TIM_CR1_CEN (1u << 0)
+#define STM32_TIM_EGR_UG  (1u << 0)
@@ -0,0 +1,18 @@
+// 호스트 시뮬레이션용 usb_main.h 대체
+#pragma once
+
+typedef enum {
+    USB_UNINIT,
+    USB_STOP,
+    USB_READY,
+    USB_SELECTED,
+    USB_ACTIVE,
+} usbstate_t;
+
+typedef struct {
+    usbstate_t state;
+} USBDriver;
+
+extern USBDriver USBD1;
+
+#define USB_DRIVER USBD1
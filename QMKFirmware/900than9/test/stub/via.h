@@ -0,0 +1,27 @@
+// 호스트 시뮬레이션용 via.h 대체: 명령 id는 QMK via.h와 같은 값
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+enum via_command_id {
+    id_dynamic_keymap_set_keycode = 0x05,
+    id_dynamic_keymap_reset       = 0x06,
+    id_custom_set_value           = 0x07,
+    id_custom_get_value           = 0x08,
+    id_custom_save                = 0x09,
+    id_eeprom_reset               = 0x0A,
+    id_dynamic_keymap_set_buffer  = 0x13,
+    id_unhandled                  = 0xFF,
+};
+
+#define VIA_EEPROM_LAYOUT_OPTIONS_DEFAULT 0x00000000
+
+bool via_eeprom_is_valid(void);
+void via_eeprom_set_valid(bool valid);
+void via_set_layout_options(uint32_t value);
+void eeconfig_init_via(void);
+
+void via_init_kb(void);
+bool via_command_kb(uint8_t* data, uint8_t length);
+void via_custom_value_command_kb(uint8_t* data, uint8_t length);
@@ -0,0 +1,37 @@
+// 호스트 테스트 공용 검사 매크로. 실패해도 계속 진행하고 test_finish()에서 종료 코드로 알림
+#pragma once
+
+#include <stdio.h>
+
+static int s_test_failures;
+static int s_test_checks;
+
+#define CHECK(cond)                                                              \
+    do                                                                           \
+    {                                                                            \
+        s_test_checks++;                                                         \
+        if (!(cond))                                                             \
+        {                                                                        \
+            s_test_failures++;                                                   \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        }                                                                        \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                         \
+    do                                                                                     \
+    {                                                                                      \
+        const long long a_ = (long long)(actual);                                          \
+        const long long e_ = (long long)(expected);                                        \
+        s_test_checks++;                                                                   \
+        if (a_ != e_)                                                                      \
+        {                                                                                  \
+            s_test_failures++;                                                             \
+            fprintf(stderr, "%s:%d: %s == %lld, expected %lld\n", __FILE__, __LINE__, #actual, a_, e_); \
+        }                                                                                  \
+    } while (0)
+
+static inline int test_finish(const char* name)
+{
+    printf("%s: %d checks, %d failed\n", name, s_test_checks, s_test_failures);
+    return s_test_failures ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+// 설정 저장: VIA 변경 -> 지연 커밋 -> 재부팅 뒤 복원, 데이터블록 이전 펌웨어(kb 워드에 raw)에서의 이전
+#include "sim.h"
+#include "test.h"
+
+#include "my_config.h"
+#include "my_effect.h"
+
+static void via_set(uint8_t channel, uint8_t value_id, uint8_t value)
+{
+    uint8_t data[32] = { id_custom_set_value, channel, value_id, value };
+    sim_via(data, sizeof(data));
+}
+
+// 커밋 조건(변경 뒤 MY_CONFIG_COMMIT_IDLE_MS, 입력 없음)을 넘기도록 대기
+static void wait_commit(void)
+{
+    sim_run_ms(MY_CONFIG_COMMIT_IDLE_MS + 500u);
+}
+
+static void test_persist(void)
+{
+    sim_eeprom_erase();
+    sim_boot();
+    wait_commit();
+    CHECK_EQ(sim_eeprom_kb_word(), EECONFIG_KB_DATA_VERSION);
+
+    via_set(MYFI_VIA_CHANNEL_LED_BASE + 1, MYFI_VIA_LED_FLAGS, LED_MODE_BREATHING);
+    via_set(MYFI_VIA_CHANNEL_INDICATOR_BASE + 2, 0, IND_SCROLL);
+    via_set(MYFI_VIA_CHANNEL_LED_BASE + 2, MYFI_VIA_LED_BRIGHTNESS, 99);
+    via_set(MYFI_VIA_CHANNEL_DEBOUNCE, 0, 7);
+    const uint32_t raw = g_my_config.raw;
+    wait_commit();
+    // kb 워드는 QMK의 데이터블록 버전으로 남아 있어야 데이터블록이 유효함
+    CHECK_EQ(sim_eeprom_kb_word(), EECONFIG_KB_DATA_VERSION);
+
+    sim_boot();
+    CHECK_EQ(g_my_config.raw, raw);
+    CHECK_EQ(my_config_get_led_flags(1), LED_MODE_BREATHING);
+    CHECK_EQ(my_config_get_indicator(2), IND_SCROLL);
+    CHECK_EQ(my_config_get_brightness(2), 99);
+    CHECK_EQ(my_config_get_debounce(), 7);
+}
+
+static void test_legacy_kb_word(void)
+{
+    sim_eeprom_erase();
+    sim_boot();
+    wait_commit();
+    via_set(MYFI_VIA_CHANNEL_LED_BASE, MYFI_VIA_LED_FLAGS, LED_MODE_FORCE_ON);
+    const uint32_t raw = g_my_config.raw;
+
+    // 데이터블록을 쓰기 전 펌웨어의 상태: raw가 kb 워드에 있고 데이터블록은 무효
+    eeconfig_update_kb(raw);
+    sim_boot();
+    CHECK_EQ(g_my_config.raw, raw);
+    CHECK_EQ(my_config_get_led_flags(0), LED_MODE_FORCE_ON);
+
+    wait_commit();
+    CHECK_EQ(sim_eeprom_kb_word(), EECONFIG_KB_DATA_VERSION);
+    sim_boot();
+    CHECK_EQ(g_my_config.raw, raw);
+}
+
+static void bulk(uint8_t* data, uint8_t command, uint8_t version)
+{
+    data[0] = command;
+    data[1] = MYFI_VIA_CHANNEL_BULK;
+    data[2] = version;
+    sim_via(data, 32);
+}
+
+// 일괄 get -> 수정 -> set -> 커밋 -> 재부팅 -> get. last_os는 set으로 바뀌지 않음
+static void test_bulk_round_trip(void)
+{
+    sim_eeprom_erase();
+    sim_boot();
+    sim_set_detected_os(OS_WINDOWS);
+    wait_commit();
+
+    uint8_t data[32] = { 0 };
+    bulk(data, id_custom_get_value, 0);
+    CHECK_EQ(data[0], id_custom_get_value);
+    CHECK_EQ(data[2], MY_CONFIG_EXT_VERSION);
+
+    uint32_t raw = 0;
+    memcpy(&raw, &data[MYFI_VIA_BULK_HEADER], sizeof(raw));
+    my_config_ext_t ext;
+    memcpy(&ext, &data[MYFI_VIA_BULK_HEADER + sizeof(raw)], sizeof(ext));
+    CHECK_EQ(raw, g_my_config.raw);
+    CHECK_EQ(ext.last_os, OS_WINDOWS);
+
+    // 다른 값으로 바꾼 프로필 (리틀 엔디언 호스트 기준). last_os는 macOS로 보냄
+    const uint32_t new_raw = (raw & ~0x1Fu) | LED_MODE_FORCE_ON;
+    ext.brightness[1] = 42;
+    ext.breath_phase[2] = 128;
+    ext.debounce_ms = 3;
+    ext.idle_light_s = 60;
+    ext.last_os = OS_MACOS;
+
+    uint8_t set[32] = { 0 };
+    memcpy(&set[MYFI_VIA_BULK_HEADER], &new_raw, sizeof(new_raw));
+    memcpy(&set[MYFI_VIA_BULK_HEADER + sizeof(new_raw)], &ext, sizeof(ext));
+    bulk(set, id_custom_set_value, MY_CONFIG_EXT_VERSION);
+    CHECK_EQ(set[0], id_custom_set_value);
+    CHECK_EQ(my_config_get_last_os(), OS_WINDOWS);
+
+    wait_commit();
+    sim_boot();
+
+    memset(data, 0, sizeof(data));
+    bulk(data, id_custom_get_value, 0);
+    uint32_t got_raw = 0;
+    my_config_ext_t got_ext;
+    memcpy(&got_raw, &data[MYFI_VIA_BULK_HEADER], sizeof(got_raw));
+    memcpy(&got_ext, &data[MYFI_VIA_BULK_HEADER + sizeof(got_raw)], sizeof(got_ext));
+    CHECK_EQ(got_raw, new_raw);
+    CHECK_EQ(my_config_get_led_flags(0), LED_MODE_FORCE_ON);
+    CHECK_EQ(got_ext.brightness[1], 42);
+    CHECK_EQ(got_ext.breath_phase[2], 128);
+    CHECK_EQ(got_ext.debounce_ms, 3);
+    CHECK_EQ(got_ext.idle_light_s, 60);
+    CHECK_EQ(got_ext.last_os, OS_WINDOWS);
+    ext.last_os = OS_WINDOWS;
+    CHECK(memcmp(&got_ext, &ext, sizeof(ext)) == 0);
+
+    // 다른 레코드 버전은 적용하지 않음
+    set[MYFI_VIA_BULK_HEADER] ^= LED_MODE_FORCE_ON;
+    bulk(set, id_custom_set_value, MY_CONFIG_EXT_VERSION + 1u);
+    CHECK_EQ(set[0], id_unhandled);
+    CHECK_EQ(g_my_config.raw, new_raw);
+}
+
+// 같은 값을 다시 보내면 아무것도 바뀌지 않으므로 저장 예약도 하지 않음: 앞선 변경의 커밋 시각이
+// 뒤로 밀리지 않고, 그 뒤로는 EEPROM 쓰기가 없어야 함
+static void test_set_same_value(void)
+{
+    sim_eeprom_erase();
+    sim_boot();
+    wait_commit();
+
+    const uint64_t before = g_sim_stats.eeprom_writes;
+    via_set(MYFI_VIA_CHANNEL_LED_BASE + 1u, MYFI_VIA_LED_BRIGHTNESS, 42);
+    sim_run_ms(MY_CONFIG_COMMIT_IDLE_MS - 500u);
+    via_set(MYFI_VIA_CHANNEL_LED_BASE + 1u, MYFI_VIA_LED_BRIGHTNESS, 42);
+    CHECK_EQ(g_sim_stats.eeprom_writes, before);
+    sim_run_ms(700);
+    CHECK(g_sim_stats.eeprom_writes > before);
+    CHECK_EQ(my_config_get_brightness(1), 42);
+
+    const uint64_t committed = g_sim_stats.eeprom_writes;
+    via_set(MYFI_VIA_CHANNEL_LED_BASE + 1u, MYFI_VIA_LED_BRIGHTNESS, 42);
+    via_set(MYFI_VIA_CHANNEL_DEBOUNCE, 0, my_config_get_debounce());
+    via_set(MYFI_VIA_CHANNEL_HOST_OS, 0, my_config_get_host_os());
+    wait_commit();
+    CHECK_EQ(g_sim_stats.eeprom_writes, committed);
+}
+
+int main(void)
+{
+    test_persist();
+    test_legacy_kb_word();
+    test_bulk_round_trip();
+    test_set_same_value();
+    return test_finish("test_config");
+}
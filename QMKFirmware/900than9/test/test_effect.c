@@ -0,0 +1,154 @@
+// LED 모드: via.json의 11개 조합을 ESC LED(채널 0)에 걸고 유휴 / 누름 직후 / 누르는 중 / 뗀 뒤 / 유휴 복귀
+// 시점의 출력을 확인. pwm 구성은 TIM3 듀티, soft 구성은 A6 핀 레벨을 샘플링함
+#include "sim.h"
+#include "test.h"
+
+#include "my_config.h"
+#include "my_effect.h"
+
+enum led_class {
+    X = 0, // 확인하지 않음
+    OFF,
+    ON,
+    BR,    // 브리딩: 창 안에서 중간 밝기로 변함
+    MIXED, // 그 밖의 변화
+};
+
+static const char* const kClassNames[] = { "x", "off", "on", "breath", "mixed" };
+
+typedef struct {
+    uint8_t flags;
+    uint8_t idle;     // A: 입력 없이 1.5s 뒤
+    uint8_t pressed;  // B: 누르고 10ms 뒤
+    uint8_t held;     // C: 누른 채 80ms 뒤
+    uint8_t released; // D: 떼고 500ms 뒤 (마지막 누름에서 1s 이내)
+    uint8_t resumed;  // E: 떼고 1.5s 뒤
+} mode_case_t;
+
+// clang-format off
+static const mode_case_t kCases[] = {
+    {  0, OFF, OFF, OFF, OFF, OFF }, // None
+    { 16, ON,  ON,  ON,  ON,  ON  }, // Force On
+    {  2, BR,  X,   X,   X,   BR  }, // Breathing
+    {  1, OFF, ON,  ON,  OFF, OFF }, // Typing Hold
+    {  4, OFF, ON,  OFF, OFF, OFF }, // Typing Edge
+    {  9, ON,  OFF, OFF, ON,  ON  }, // Hold + Invert
+    { 12, ON,  OFF, ON,  ON,  ON  }, // Edge + Invert
+    {  6, BR,  ON,  OFF, OFF, BR  }, // Edge + Breathing
+    {  3, BR,  ON,  ON,  OFF, BR  }, // Hold + Breathing
+    { 11, BR,  OFF, OFF, ON,  BR  }, // Hold + Breathing + Invert
+    { 14, BR,  OFF, ON,  ON,  BR  }, // Edge + Breathing + Invert
+};
+// clang-format on
+
+// 타이핑 키: Q (행 2, 열 2)
+#define KEY_ROW 2
+#define KEY_COL 2
+
+static uint32_t led_output(void)
+{
+#ifdef MYFI_LED_DRIVER_PWM
+    return sim_pwm_width(0);
+#else
+    return sim_pin_level(A6) ? MY_LED_DUTY_MAX : 0u;
+#endif
+}
+
+// ms 동안 루프를 돌며 출력을 샘플링해서 분류
+static uint8_t sample_class(uint32_t ms)
+{
+    uint32_t lo = UINT32_MAX;
+    uint32_t hi = 0;
+    const uint64_t end = g_sim_us + (uint64_t)ms * 1000u;
+    while (g_sim_us < end)
+    {
+        sim_task();
+        const uint32_t v = led_output();
+        if (v < lo) lo = v;
+        if (v > hi) hi = v;
+    }
+    if (hi == 0) return OFF;
+    if (lo == MY_LED_DUTY_MAX) return ON;
+#ifdef MYFI_LED_DRIVER_PWM
+    // 하드웨어 PWM: 듀티가 꺼짐 없이 변함 (브리딩 최고점은 최대 밝기)
+    if (lo > 0 && lo < hi) return BR;
+#else
+    // 소프트웨어 PWM: 중간 밝기면 핀이 토글됨
+    if (lo == 0 && hi == MY_LED_DUTY_MAX) return BR;
+#endif
+    return MIXED;
+}
+
+static void via_set(uint8_t channel, uint8_t value_id, uint8_t value)
+{
+    uint8_t data[32] = { id_custom_set_value, channel, value_id, value };
+    sim_via(data, sizeof(data));
+}
+
+static void expect_class(const mode_case_t* c, const char* point, uint8_t expected, uint8_t actual)
+{
+    if (expected == X) return;
+    s_test_checks++;
+    if (expected != actual)
+    {
+        s_test_failures++;
+        fprintf(stderr, "mode %u at %s: %s, expected %s\n", c->flags, point, kClassNames[actual], kClassNames[expected]);
+    }
+}
+
+static void test_mode(const mode_case_t* c)
+{
+    via_set(MYFI_VIA_CHANNEL_LED_BASE, MYFI_VIA_LED_FLAGS, c->flags);
+
+    sim_run_ms(1500);
+    expect_class(c, "idle", c->idle, sample_class(1u << EFFECT_BREATH_PERIOD_SHIFT >> 1));
+
+    sim_key(KEY_ROW, KEY_COL, true);
+    sim_run_ms(8);
+    expect_class(c, "press", c->pressed, sample_class(4));
+    sim_run_ms(68);
+    expect_class(c, "held", c->held, sample_class(4));
+    sim_run_ms(20);
+
+    sim_key(KEY_ROW, KEY_COL, false);
+    sim_run_ms(498);
+    expect_class(c, "release", c->released, sample_class(4));
+    sim_run_ms(998);
+    expect_class(c, "resume", c->resumed, sample_class(1u << EFFECT_BREATH_PERIOD_SHIFT >> 1));
+}
+
+static void test_indicator(void)
+{
+    via_set(MYFI_VIA_CHANNEL_LED_BASE, MYFI_VIA_LED_FLAGS, LED_MODE_NONE);
+    via_set(MYFI_VIA_CHANNEL_INDICATOR_BASE, 0, IND_CAPS);
+    sim_run_ms(10);
+    CHECK_EQ(sample_class(10), OFF);
+
+    sim_set_host_leds(0x02); // caps lock
+    CHECK_EQ(sample_class(10), ON);
+    // 인디케이터가 켜진 동안은 이펙트(Force On 아님)를 무시
+    via_set(MYFI_VIA_CHANNEL_LED_BASE, MYFI_VIA_LED_FLAGS, 9);
+    CHECK_EQ(sample_class(10), ON);
+
+    sim_set_host_leds(0x00);
+    CHECK_EQ(sample_class(10), ON); // Hold + Invert, 키 안 누름
+    via_set(MYFI_VIA_CHANNEL_LED_BASE, MYFI_VIA_LED_FLAGS, LED_MODE_NONE);
+    CHECK_EQ(sample_class(10), OFF);
+    via_set(MYFI_VIA_CHANNEL_INDICATOR_BASE, 0, IND_NONE);
+}
+
+int main(void)
+{
+    sim_eeprom_erase();
+    sim_boot();
+    // 미뤄 둔 LED 초기화(MY_BOOT_DEFER_MAX_MS)가 끝나도록 대기
+    sim_run_ms(2000);
+    CHECK_EQ(my_config_get_indicator(0), IND_NONE);
+
+    for (size_t i = 0; i < ARRAY_SIZE(kCases); i++)
+    {
+        test_mode(&kCases[i]);
+    }
+    test_indicator();
+    return test_finish("test_effect");
+}
@@ -0,0 +1,187 @@
+// 커스텀 키코드: 14개 키코드를 Windows / macOS 감지 상태에서 각각 한 번씩 탭하고
+// 호스트가 받은 보고서 시퀀스(모디파이어, 키)와 USB 프레임당 보고서 하나를 확인
+#include "sim.h"
+#include "test.h"
+
+#include "my_keycode.h"
+
+// 키코드를 놓을 자리: Q (레이어 0, 행 2, 열 2)
+#define KEY_ROW 2
+#define KEY_COL 2
+
+#define R_CTL  0x01u
+#define R_SFT  0x02u
+#define R_ALT  0x04u
+#define R_GUI  0x08u
+#define R_RALT 0x40u
+
+#define MAX_REPORTS 4
+
+typedef struct {
+    uint8_t mods;
+    uint8_t key; // 0 = 키 없음
+} expected_report_t;
+
+typedef struct {
+    uint16_t          keycode;
+    const char*       name;
+    uint8_t           count;
+    expected_report_t reports[MAX_REPORTS]; // 누름 -> 뗌 전체
+} keycode_case_t;
+
+// clang-format off
+static const keycode_case_t kWinCases[] = {
+    { GO_LEFT, "GO_LEFT", 2, { { R_GUI | R_CTL, KC_LEFT },  { 0, 0 } } },
+    { GO_RGHT, "GO_RGHT", 2, { { R_GUI | R_CTL, KC_RIGHT }, { 0, 0 } } },
+    { GO_UP,   "GO_UP",   2, { { R_GUI, KC_TAB },           { 0, 0 } } },
+    { WO_LEFT, "WO_LEFT", 2, { { R_CTL, KC_LEFT },          { 0, 0 } } },
+    { WO_RGHT, "WO_RGHT", 2, { { R_CTL, KC_RIGHT },         { 0, 0 } } },
+    { OS_LANG, "OS_LANG", 2, { { R_RALT, 0 },               { 0, 0 } } },
+    { OS_PSCR, "OS_PSCR", 2, { { R_GUI | R_SFT, KC_S },     { 0, 0 } } },
+    { MC_LCMD, "MC_LCMD", 2, { { R_CTL, 0 },                { 0, 0 } } },
+    { MC_LCTL, "MC_LCTL", 2, { { R_GUI, 0 },                { 0, 0 } } },
+    { VS_BRCK, "VS_BRCK", 2, { { R_CTL | R_ALT, KC_PAUS },  { 0, 0 } } },
+    { VC_FLDA, "VC_FLDA", 4, { { R_CTL, KC_K }, { R_CTL, 0 }, { R_CTL, KC_0 },    { 0, 0 } } },
+    { VC_UFDA, "VC_UFDA", 4, { { R_CTL, KC_K }, { R_CTL, 0 }, { R_CTL, KC_J },    { 0, 0 } } },
+    { VC_FLDR, "VC_FLDR", 4, { { R_CTL, KC_K }, { R_CTL, 0 }, { R_CTL, KC_LBRC }, { 0, 0 } } },
+    { VC_UFDR, "VC_UFDR", 4, { { R_CTL, KC_K }, { R_CTL, 0 }, { R_CTL, KC_RBRC }, { 0, 0 } } },
+};
+
+static const keycode_case_t kMacCases[] = {
+    { GO_LEFT, "GO_LEFT", 2, { { R_CTL, KC_LEFT },          { 0, 0 } } },
+    { GO_RGHT, "GO_RGHT", 2, { { R_CTL, KC_RIGHT },         { 0, 0 } } },
+    { GO_UP,   "GO_UP",   2, { { R_CTL, KC_UP },            { 0, 0 } } },
+    { WO_LEFT, "WO_LEFT", 2, { { R_ALT, KC_LEFT },          { 0, 0 } } },
+    { WO_RGHT, "WO_RGHT", 2, { { R_ALT, KC_RIGHT },         { 0, 0 } } },
+    { OS_LANG, "OS_LANG", 2, { { R_CTL, KC_SPACE },         { 0, 0 } } },
+    { OS_PSCR, "OS_PSCR", 2, { { R_GUI | R_SFT, KC_4 },     { 0, 0 } } },
+    { MC_LCMD, "MC_LCMD", 2, { { R_GUI, 0 },                { 0, 0 } } },
+    { MC_LCTL, "MC_LCTL", 2, { { R_CTL, 0 },                { 0, 0 } } },
+    { VS_BRCK, "VS_BRCK", 2, { { 0, KC_PAUS },              { 0, 0 } } },
+    { VC_FLDA, "VC_FLDA", 4, { { R_GUI, KC_K }, { R_GUI, 0 }, { R_GUI, KC_0 },    { 0, 0 } } },
+    { VC_UFDA, "VC_UFDA", 4, { { R_GUI, KC_K }, { R_GUI, 0 }, { R_GUI, KC_J },    { 0, 0 } } },
+    { VC_FLDR, "VC_FLDR", 4, { { R_GUI, KC_K }, { R_GUI, 0 }, { R_GUI, KC_LBRC }, { 0, 0 } } },
+    { VC_UFDR, "VC_UFDR", 4, { { R_GUI, KC_K }, { R_GUI, 0 }, { R_GUI, KC_RBRC }, { 0, 0 } } },
+};
+// clang-format on
+
+_Static_assert(ARRAY_SIZE(kWinCases) == MY_KEYCODE_COUNT, "every custom keycode needs a Windows case");
+_Static_assert(ARRAY_SIZE(kMacCases) == MY_KEYCODE_COUNT, "every custom keycode needs a macOS case");
+
+static void set_keycode(uint8_t layer, uint8_t row, uint8_t col, uint16_t keycode)
+{
+    uint8_t data[32] = { id_dynamic_keymap_set_keycode, layer, row, col, (uint8_t)(keycode >> 8), (uint8_t)keycode };
+    sim_via(data, sizeof(data));
+}
+
+static bool report_matches(const sim_report_t* r, const expected_report_t* e)
+{
+    if (r->mods != e->mods) return false;
+    if (e->key == 0) return sim_report_key_count(r) == 0;
+    return sim_report_key_count(r) == 1 && sim_report_has_key(r, e->key);
+}
+
+static void check_case(const char* os, const keycode_case_t* c)
+{
+    set_keycode(0, KEY_ROW, KEY_COL, c->keycode);
+    sim_run_ms(10);
+    sim_reports_clear();
+
+    // 누른 채 20ms (HOLD 키는 여기서 누름 보고서만 나감), 뗀 뒤 20ms
+    sim_key(KEY_ROW, KEY_COL, true);
+    sim_run_ms(20);
+    sim_key(KEY_ROW, KEY_COL, false);
+    sim_run_ms(20);
+
+    const size_t count = sim_report_count();
+    s_test_checks++;
+    if (count != c->count)
+    {
+        s_test_failures++;
+        fprintf(stderr, "%s %s: %zu reports, expected %u\n", os, c->name, count, c->count);
+        return;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        const sim_report_t* r = sim_report(i);
+        s_test_checks++;
+        if (!report_matches(r, &c->reports[i]))
+        {
+            s_test_failures++;
+            fprintf(stderr, "%s %s: report %zu mods 0x%02x keys %u, expected mods 0x%02x key 0x%02x\n", os, c->name, i,
+                    r->mods, sim_report_key_count(r), c->reports[i].mods, c->reports[i].key);
+        }
+        // 모든 보고서가 호스트에 전달되고, 연속 보고서는 서로 다른 USB 프레임에서 전송됨
+        CHECK(r->delivered_us != 0);
+        if (i > 0) CHECK(r->sent_us / 1000u != sim_report(i - 1)->sent_us / 1000u);
+    }
+}
+
+static void check_os(const char* name, os_variant_t os, const keycode_case_t* cases, size_t count)
+{
+    sim_set_detected_os(os);
+    for (size_t i = 0; i < count; i++)
+    {
+        check_case(name, &cases[i]);
+    }
+}
+
+// 시퀀스 재생 중에 누른 키는 재생이 끝난 뒤에 단축키 mods 없이 전송됨
+static void check_rollover_during_macro(void)
+{
+    sim_set_detected_os(OS_WINDOWS);
+    set_keycode(0, KEY_ROW, KEY_COL, VC_FLDA);
+    sim_run_ms(10);
+    sim_reports_clear();
+
+    // VC_FLDA를 누르고 다음 스캔에서 S(행 3, 열 3)를 누름. 시퀀스 보고서 4개가 나가는 동안 S는 보류
+    sim_key(KEY_ROW, KEY_COL, true);
+    sim_run_ms(1);
+    sim_key(3, 3, true);
+    sim_run_ms(1);
+    sim_key(KEY_ROW, KEY_COL, false);
+    sim_run_ms(20);
+    sim_key(3, 3, false);
+    sim_run_ms(20);
+
+    CHECK_EQ(sim_report_count(), 6);
+    for (size_t i = 0; i < sim_report_count(); i++)
+    {
+        const sim_report_t* r = sim_report(i);
+        if (sim_report_has_key(r, KC_S)) CHECK_EQ(r->mods, 0);
+    }
+    if (sim_report_count() == 6)
+    {
+        CHECK(report_matches(sim_report(2), &(expected_report_t){ R_CTL, KC_0 }));
+        CHECK(report_matches(sim_report(3), &(expected_report_t){ 0, 0 }));
+        CHECK(report_matches(sim_report(4), &(expected_report_t){ 0, KC_S }));
+        CHECK(report_matches(sim_report(5), &(expected_report_t){ 0, 0 }));
+        CHECK(sim_report(4)->sent_us / 1000u != sim_report(3)->sent_us / 1000u);
+    }
+}
+
+int main(void)
+{
+    sim_eeprom_erase();
+    sim_boot();
+    sim_run_ms(2000);
+
+    check_os("win", OS_WINDOWS, kWinCases, ARRAY_SIZE(kWinCases));
+    check_os("mac", OS_MACOS, kMacCases, ARRAY_SIZE(kMacCases));
+
+    // 일반 키코드는 커스텀 처리를 거치지 않고 보고서 두 개 (누름, 뗌)
+    set_keycode(0, KEY_ROW, KEY_COL, KC_Q);
+    sim_run_ms(10);
+    sim_reports_clear();
+    sim_key(KEY_ROW, KEY_COL, true);
+    sim_run_ms(20);
+    sim_key(KEY_ROW, KEY_COL, false);
+    sim_run_ms(20);
+    CHECK_EQ(sim_report_count(), 2);
+    CHECK(sim_report_has_key(sim_report(0), KC_Q));
+    CHECK_EQ(sim_report_key_count(sim_report(1)), 0);
+
+    check_rollover_during_macro();
+
+    return test_finish("test_keycode");
+}
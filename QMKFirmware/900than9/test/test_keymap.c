@@ -0,0 +1,143 @@
+// 희소 기본 레이어: EEPROM 초기화 / VIA 키맵 초기화 / VIA EEPROM 초기화 뒤의 동적 키맵이
+// 이전의 조밀한 keymaps[] 6레이어(레이어 1~3은 XXXXXXX + 양쪽 MO(1), 4~5는 _______)와 같은지 확인
+#include "sim.h"
+#include "test.h"
+
+#include "dynamic_keymap.h"
+#include "keymap_introspection.h"
+#include "my_keymap.h"
+
+// 희소 목록으로 옮기기 전의 조밀한 keymaps[] 레이어 1~3 (기준 커밋에서 그대로 옮겨 옴)
+static const uint16_t kDenseLayers[][MATRIX_ROWS][MATRIX_COLS] = {
+    // clang-format off
+    [1] = LAYOUT(
+        XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX,
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX,
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,             XXXXXXX, XXXXXXX, XXXXXXX,
+        XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+        MO(1),   XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX, MO(1),               XXXXXXX,
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX,          XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX
+    ),
+    [2] = LAYOUT(
+        XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX,
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX,
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,             XXXXXXX, XXXXXXX, XXXXXXX,
+        XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+        MO(1),   XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX, MO(1),               XXXXXXX,
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX,          XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX
+    ),
+    [3] = LAYOUT(
+        XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX,
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX,
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,             XXXXXXX, XXXXXXX, XXXXXXX,
+        XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+        MO(1),   XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX, MO(1),               XXXXXXX,
+        XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,          XXXXXXX,          XXXXXXX,          XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX
+    ),
+    // clang-format on
+};
+
+static uint16_t dense_keycode(uint8_t layer, uint8_t row, uint8_t col)
+{
+    if (layer == 0) return keycode_at_keymap_location_raw(0, row, col);
+    if (layer <= 3) return kDenseLayers[layer][row][col];
+    return _______;
+}
+
+static void check_dense_identity(const char* when)
+{
+    int mismatches = 0;
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++)
+    {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++)
+        {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++)
+            {
+                const uint16_t expected = dense_keycode(layer, row, col);
+                const keypos_t key = { .col = col, .row = row };
+                // EEPROM 값과 스캔 경로(캐시)가 보는 값 모두 확인
+                if (dynamic_keymap_get_keycode(layer, row, col) != expected || keymap_key_to_keycode(layer, key) != expected)
+                {
+                    if (mismatches++ < 8)
+                    {
+                        fprintf(stderr, "%s: layer %u [%u][%u] = 0x%04x / 0x%04x, expected 0x%04x\n", when, layer, row, col,
+                                dynamic_keymap_get_keycode(layer, row, col), keymap_key_to_keycode(layer, key), expected);
+                    }
+                }
+            }
+        }
+    }
+    s_test_checks++;
+    if (mismatches) s_test_failures++;
+}
+
+static void via(uint8_t command, uint8_t layer, uint8_t row, uint8_t col, uint16_t keycode)
+{
+    uint8_t data[32] = { command, layer, row, col, (uint8_t)(keycode >> 8), (uint8_t)keycode };
+    sim_via(data, sizeof(data));
+}
+
+// 몇 자리를 바꿔 두고 초기화 명령이 희소 레이어까지 되돌리는지 확인
+static void scribble(void)
+{
+    via(id_dynamic_keymap_set_keycode, 0, 2, 2, KC_Z);
+    via(id_dynamic_keymap_set_keycode, 1, 4, 0, KC_A);
+    via(id_dynamic_keymap_set_keycode, 3, 0, 5, KC_B);
+    via(id_dynamic_keymap_set_keycode, 5, 5, 17, KC_C);
+    CHECK_EQ(dynamic_keymap_get_keycode(1, 4, 0), KC_A);
+    CHECK_EQ(keymap_key_to_keycode(3, (keypos_t){ .col = 5, .row = 0 }), KC_B);
+}
+
+int main(void)
+{
+    CHECK_EQ(g_my_sparse_layer_count, 3);
+
+    // 캐시는 무효화 호출 없이 .bss 상태 그대로도 빈 캐시여야 함 (VIA를 거치지 않고 직접 씀)
+    dynamic_keymap_set_keycode(0, 2, 2, KC_Q);
+    CHECK_EQ(keymap_key_to_keycode(0, (keypos_t){ .col = 2, .row = 2 }), KC_Q);
+
+    sim_eeprom_erase();
+    sim_boot();
+    check_dense_identity("erased eeprom");
+
+    // 재부팅은 EEPROM을 그대로 둠
+    uint64_t writes = g_sim_stats.eeprom_writes;
+    scribble();
+    const uint64_t scribbled = g_sim_stats.eeprom_writes - writes;
+    CHECK(scribbled > 0);
+    sim_boot();
+    CHECK_EQ(dynamic_keymap_get_keycode(1, 4, 0), KC_A);
+
+    // 초기화는 레이어마다 한 번씩만 쓰므로 EEPROM에는 바꿔 둔 바이트만 되돌려 씀
+    scribble();
+    writes = g_sim_stats.eeprom_writes;
+    via(id_dynamic_keymap_reset, 0, 0, 0, 0);
+    CHECK_EQ(g_sim_raw_hid_response[0], id_dynamic_keymap_reset);
+    CHECK_EQ(g_sim_stats.eeprom_writes - writes, scribbled);
+    check_dense_identity("dynamic keymap reset");
+
+    writes = g_sim_stats.eeprom_writes;
+    via(id_dynamic_keymap_reset, 0, 0, 0, 0);
+    CHECK_EQ(g_sim_stats.eeprom_writes - writes, 0);
+
+    scribble();
+    writes = g_sim_stats.eeprom_writes;
+    via(id_eeprom_reset, 0, 0, 0, 0);
+    CHECK_EQ(g_sim_raw_hid_response[0], id_eeprom_reset);
+    CHECK_EQ(g_sim_stats.eeprom_writes - writes, scribbled);
+    check_dense_identity("eeprom reset");
+
+    // MO(1)은 희소 레이어에서도 동작: 누르는 동안 레이어 1의 Q 자리는 XXXXXXX
+    sim_run_ms(2000);
+    sim_reports_clear();
+    sim_key(4, 0, true);
+    sim_run_ms(10);
+    sim_key(2, 2, true);
+    sim_run_ms(10);
+    sim_key(2, 2, false);
+    sim_key(4, 0, false);
+    sim_run_ms(20);
+    CHECK_EQ(sim_report_count(), 0);
+
+    return test_finish("test_keymap");
+}
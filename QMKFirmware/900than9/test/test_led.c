@@ -0,0 +1,80 @@
+// LED 드라이버: 256단계 밝기마다 출력 듀티가 CIE 1931 감마 곡선과 같은지 확인
+// pwm 구성은 TIM3 듀티 값, soft 구성은 시그마-델타 변조기의 장기 평균 듀티(MY_LED_DUTY_MAX의 배수 루프)
+#include <math.h>
+
+#include "sim.h"
+#include "test.h"
+
+#include "my_led.h"
+
+// my_led.c의 테이블 생성식과 독립적으로 계산한 기대 듀티
+static double cie_duty(uint16_t level)
+{
+    const double l = level * 100.0 / 255.0;
+    const double y = (l > 8.0) ? pow((l + 16.0) / 116.0, 3.0) : l / 903.3;
+    return y * MY_LED_DUTY_MAX;
+}
+
+#ifndef MYFI_LED_DRIVER_PWM
+// 듀티 주기 한 번 = my_led_task MY_LED_DUTY_MAX번
+#define SD_PERIODS 4u
+
+static uint32_t count_high(pin_t pin, uint32_t tasks)
+{
+    uint32_t high = 0;
+    for (uint32_t i = 0; i < tasks; i++)
+    {
+        my_led_task();
+        if (sim_pin_level(pin)) high++;
+    }
+    return high;
+}
+#endif
+
+int main(void)
+{
+    my_led_init();
+
+    int worst_level = -1;
+    double worst_error = 0.0;
+    for (uint16_t level = 0; level <= MY_LED_FULL; level++)
+    {
+        my_led_set(0, (uint8_t)level);
+        const double expected = cie_duty(level);
+#ifdef MYFI_LED_DRIVER_PWM
+        const double actual = sim_pwm_width(0);
+        // 테이블은 반올림한 정수 듀티
+        const double tolerance = 0.5;
+#else
+        const double actual = (double)count_high(A6, MY_LED_DUTY_MAX * SD_PERIODS) / SD_PERIODS;
+        // 반올림 0.5 + 누산기 초기 위상에 따른 주기 전체 오차 1 / SD_PERIODS
+        const double tolerance = 0.5 + 1.0 / SD_PERIODS;
+#endif
+        const double error = fabs(actual - expected);
+        if (error > worst_error)
+        {
+            worst_error = error;
+            worst_level = level;
+        }
+        s_test_checks++;
+        if (error > tolerance + 1e-9)
+        {
+            s_test_failures++;
+            fprintf(stderr, "level %u: duty %.3f, expected %.3f\n", level, actual, expected);
+        }
+    }
+    printf("worst duty error %.3f / %u at level %d\n", worst_error, MY_LED_DUTY_MAX, worst_level);
+
+    // 양 끝은 정확히 꺼짐 / 항상 켜짐
+    my_led_set(0, MY_LED_OFF);
+#ifdef MYFI_LED_DRIVER_PWM
+    CHECK_EQ(sim_pwm_width(0), 0);
+    my_led_set(0, MY_LED_FULL);
+    CHECK_EQ(sim_pwm_width(0), MY_LED_DUTY_MAX);
+#else
+    CHECK_EQ(count_high(A6, MY_LED_DUTY_MAX), 0);
+    my_led_set(0, MY_LED_FULL);
+    CHECK_EQ(count_high(A6, MY_LED_DUTY_MAX), MY_LED_DUTY_MAX);
+#endif
+    return test_finish("test_led");
+}
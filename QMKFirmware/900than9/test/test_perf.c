@@ -0,0 +1,221 @@
+// 핫패스 계측 (MYFI_PERF_ENABLE, soft 구성): VIA 채널 40으로 읽은 값 확인
+#include "sim.h"
+#include "test.h"
+
+#include "my_config.h"
+#include "my_effect.h"
+#include "my_idle.h"
+#include "my_keycode.h"
+#include "my_perf.h"
+
+#ifdef MYFI_PERF_ENABLE
+static void via(uint8_t* data, uint8_t command, uint8_t channel, uint8_t value_id)
+{
+    memset(data, 0, 32);
+    data[0] = command;
+    data[1] = channel;
+    data[2] = value_id;
+    sim_via(data, 32);
+}
+
+static void put_u32(uint8_t* p, uint32_t v)
+{
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void set_all_leds(uint8_t flags)
+{
+    uint8_t data[32];
+    for (uint8_t i = 0; i < MY_LED_COUNT; i++)
+    {
+        via(data, id_custom_set_value, MYFI_VIA_CHANNEL_LED_BASE + i, MYFI_VIA_LED_FLAGS);
+        data[3] = flags;
+        sim_via(data, sizeof(data));
+    }
+}
+
+static uint32_t read_overruns(void)
+{
+    uint8_t data[32];
+    via(data, id_custom_get_value, MYFI_VIA_CHANNEL_PERF, 0);
+    return get_u32(&data[5]);
+}
+
+// 스캔 감속(LIGHT) 단계의 10ms 간격은 오버런이 아님
+static void test_idle_scans_are_not_overruns(void)
+{
+    uint8_t data[32] = { id_custom_set_value, MYFI_VIA_CHANNEL_IDLE, MYFI_VIA_IDLE_LIGHT_S, 1 };
+    sim_via(data, sizeof(data));
+    via(data, id_custom_set_value, MYFI_VIA_CHANNEL_PERF, 0); // 초기화
+
+    sim_run_ms(3000);
+    CHECK_EQ(my_idle_level(), MY_IDLE_LIGHT);
+    CHECK_EQ(read_overruns(), 0);
+
+    // 감속 중 누름 -> ACTIVE 복귀 뒤에도 정상 간격이면 오버런 없음
+    sim_key(2, 2, true);
+    sim_run_ms(30);
+    sim_key(2, 2, false);
+    sim_run_ms(30);
+    CHECK_EQ(read_overruns(), 0);
+
+    // ACTIVE 상태에서 메인 루프가 멈추면 오버런
+    sim_key(2, 2, true);
+    sim_run_ms(5);
+    CHECK_EQ(my_idle_level(), MY_IDLE_ACTIVE);
+    g_sim_loop_us = 3000u;
+    sim_run_ms(10);
+    g_sim_loop_us = 100u;
+    sim_key(2, 2, false);
+    CHECK(read_overruns() > 0);
+}
+
+static void write_baseline(uint8_t metric, uint32_t value)
+{
+    uint8_t data[32] = { id_custom_set_value, MYFI_VIA_CHANNEL_PERF, 2, metric };
+    put_u32(&data[4], value);
+    sim_via(data, sizeof(data));
+}
+
+static uint8_t read_regression_flags(void)
+{
+    uint8_t data[32];
+    via(data, id_custom_get_value, MYFI_VIA_CHANNEL_PERF, 4);
+    return data[3 + MY_PERF_COUNTER_COUNT * 4];
+}
+
+// 기준값은 VIA로 읽고 다시 쓸 수 있고, 통계 초기화로 지워지지 않음
+static void test_baseline_round_trip(void)
+{
+    for (uint8_t metric = 0; metric < MY_PERF_METRIC_COUNT; metric++)
+    {
+        write_baseline(metric, 0x12345678u + ((uint32_t)metric << 24));
+    }
+    uint8_t data[32];
+    via(data, id_custom_set_value, MYFI_VIA_CHANNEL_PERF, 0); // 초기화
+
+    for (uint8_t metric = 0; metric < MY_PERF_METRIC_COUNT; metric++)
+    {
+        uint8_t get[32] = { id_custom_get_value, MYFI_VIA_CHANNEL_PERF, 6, metric };
+        sim_via(get, sizeof(get));
+        CHECK_EQ(get[3], metric);
+        CHECK_EQ(get_u32(&get[4]), 0x12345678u + ((uint32_t)metric << 24));
+    }
+
+    // 기준값이 충분히 크면 회귀 비트 없음, 0으로 쓰면 해당 지표(스캔당 핀 쓰기)만 회귀
+    sim_run_ms(100);
+    CHECK_EQ(read_regression_flags(), 0);
+    write_baseline(MY_PERF_SLOT_COUNT + MY_PERF_CNT_PIN_WRITE, 0);
+    set_all_leds(LED_MODE_BREATHING);
+    sim_run_ms(100);
+    CHECK_EQ(read_regression_flags(), 1u << (MY_PERF_SLOT_COUNT + MY_PERF_CNT_PIN_WRITE));
+    set_all_leds(LED_MODE_NONE);
+
+    // 범위 밖 지표는 읽기 거부
+    uint8_t get[32] = { id_custom_get_value, MYFI_VIA_CHANNEL_PERF, 6, MY_PERF_METRIC_COUNT };
+    sim_via(get, sizeof(get));
+    CHECK_EQ(get[0], id_unhandled);
+}
+
+typedef struct {
+    uint32_t samples;
+    uint16_t max_us;
+} latency_t;
+
+static uint16_t get_u16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static latency_t read_latency(void)
+{
+    uint8_t data[32];
+    via(data, id_custom_get_value, MYFI_VIA_CHANNEL_PERF, 5);
+    return (latency_t){ .samples = get_u32(&data[3]), .max_us = get_u16(&data[11]) };
+}
+
+static void tap(uint8_t row, uint8_t col)
+{
+    sim_key(row, col, true);
+    sim_run_ms(20);
+    sim_key(row, col, false);
+    sim_run_ms(20);
+}
+
+// 지연은 누른 키가 들어간 보고서에서만 닫힘
+static void test_latency_attribution(void)
+{
+    uint8_t data[32];
+
+    // MO(1)은 보고서가 없으므로 표본 없음. 누른 채 친 W(레이어 1 = XXXXXXX)도 보고서 없음
+    via(data, id_custom_set_value, MYFI_VIA_CHANNEL_PERF, 0);
+    sim_key(4, 0, true);
+    sim_run_ms(20);
+    tap(2, 2);
+    sim_key(4, 0, false);
+    sim_run_ms(20);
+    CHECK_EQ(read_latency().samples, 0);
+
+    // MO를 누르고 있다가 뗀 뒤 친 키는 자기 보고서로만 계측 (MO 누름이 이 보고서로 닫히지 않음)
+    sim_key(4, 0, true);
+    sim_run_ms(20);
+    sim_key(4, 0, false);
+    sim_run_ms(10);
+    tap(2, 2);
+    latency_t lat = read_latency();
+    CHECK_EQ(lat.samples, 1);
+    CHECK(lat.max_us < 2000u);
+
+    // 모디파이어 단독 누름은 mod 비트로 판정
+    via(data, id_custom_set_value, MYFI_VIA_CHANNEL_PERF, 0);
+    tap(4, 1);
+    lat = read_latency();
+    CHECK_EQ(lat.samples, 1);
+    CHECK(lat.max_us < 2000u);
+
+    // 보고서 4개짜리 단축키 재생 중에 누른 S는 재생이 끝난 뒤 자기 보고서가 나갈 때 닫힘
+    // (앞 키의 시퀀스 보고서로 닫히면 1ms 안쪽으로 잘못 잼)
+    uint8_t set[32] = { id_dynamic_keymap_set_keycode, 0, 2, 2, (uint8_t)(VC_FLDA >> 8), (uint8_t)VC_FLDA };
+    sim_via(set, sizeof(set));
+    sim_set_detected_os(OS_WINDOWS);
+    sim_run_ms(10);
+    via(data, id_custom_set_value, MYFI_VIA_CHANNEL_PERF, 0);
+    sim_key(2, 2, true);
+    sim_run_ms(1);
+    sim_key(3, 3, true);
+    sim_run_ms(20);
+    sim_key(2, 2, false);
+    sim_key(3, 3, false);
+    sim_run_ms(20);
+    lat = read_latency();
+    CHECK_EQ(lat.samples, 2);
+    CHECK(lat.max_us >= 3000u);
+
+    set[4] = 0;
+    set[5] = KC_W;
+    sim_via(set, sizeof(set));
+}
+#endif
+
+int main(void)
+{
+#ifdef MYFI_PERF_ENABLE
+    sim_eeprom_erase();
+    sim_boot();
+    sim_run_ms(2000);
+    test_idle_scans_are_not_overruns();
+    test_baseline_round_trip();
+    test_latency_attribution();
+#else
+    printf("test_perf: MYFI_PERF_ENABLE not set, skipped\n");
+#endif
+    return test_finish("test_perf");
+}